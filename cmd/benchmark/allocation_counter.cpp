@@ -0,0 +1,31 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "allocation_counter.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> allocations{0};
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr{std::malloc(size == 0 ? 1 : size)}; ptr != nullptr) [[likely]] {
+        return ptr;
+    }
+    std::abort();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace zen {
+
+uint64_t allocations_count() noexcept { return allocations.load(std::memory_order_relaxed); }
+
+}  // namespace zen
@@ -0,0 +1,18 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace zen {
+
+//! \brief Returns the number of heap allocations made so far by the whole benchmark binary
+//! \remarks Counted by the replacement of the global operator new in allocation_counter.cpp : benchmarks report
+//! allocations as the difference between two readings
+[[nodiscard]] uint64_t allocations_count() noexcept;
+
+}  // namespace zen
@@ -18,9 +18,11 @@
 #include <limits.h>
 #include <unistd.h>
 
+#include <mach/mach_host.h>
 #include <mach/mach_init.h>
 #include <mach/task.h>
 #include <sys/mman.h>
+#include <sys/sysctl.h>
 #endif
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -88,6 +90,40 @@ size_t get_system_page_size() {
     return ret;
 }
 
+size_t get_physical_memory(bool available) {
+    size_t ret{0};
+#if defined(__linux__)
+    const long pages{sysconf(available ? _SC_AVPHYS_PAGES : _SC_PHYS_PAGES)};
+    const long page_size{sysconf(_SC_PAGESIZE)};
+    if (pages > 0 && page_size > 0) ret = static_cast<size_t>(pages) * static_cast<size_t>(page_size);
+
+#elif defined(__APPLE__)
+    if (available) {
+        vm_statistics64_data_t vm_stats;
+        mach_msg_type_number_t count = HOST_VM_INFO64_COUNT;
+        if (host_statistics64(mach_host_self(), HOST_VM_INFO64, reinterpret_cast<host_info64_t>(&vm_stats), &count) ==
+            KERN_SUCCESS) {
+            ret = static_cast<size_t>(vm_stats.free_count) * static_cast<size_t>(getpagesize());
+        }
+    } else {
+        uint64_t mem_size{0};
+        size_t len{sizeof(mem_size)};
+        if (sysctlbyname("hw.memsize", &mem_size, &len, nullptr, 0) == 0) ret = static_cast<size_t>(mem_size);
+    }
+
+#elif defined(_WIN32) || defined(_WIN64)
+    MEMORYSTATUSEX status;
+    status.dwLength = sizeof(status);
+    if (GlobalMemoryStatusEx(&status)) {
+        ret = static_cast<size_t>(available ? status.ullAvailPhys : status.ullTotalPhys);
+    }
+#else
+    // Unsupported platform
+    (void)available;  // disable unused-parameter warning
+#endif
+    return ret;
+}
+
 void memory_cleanse(void* ptr, size_t size) {
 #if defined(WIN32)
     SecureZeroMemory(ptr, size);
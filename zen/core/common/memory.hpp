@@ -27,6 +27,11 @@ namespace zen {
 //! \brief Returns system's page size in bytes
 [[nodiscard]] size_t get_system_page_size();
 
+//! \brief Returns the amount of physical memory (RAM) of the system, in bytes.
+//! \remarks if available=true it reports the memory not currently in use (free) otherwise the total installed. Returns
+//! 0 on unsupported platforms
+[[nodiscard]] size_t get_physical_memory(bool available = false);
+
 //! \brief Fills ptr of size with a string of 0s
 void memory_cleanse(void* ptr, size_t size);
 
@@ -27,6 +27,10 @@ TEST_CASE("System Memory", "[memory]") {
     REQUIRE(sys_page_size > 0);
     REQUIRE((sys_page_size & (sys_page_size - 1)) == 0);  // Must be power of 2
     std::cout << "Using " << zen::to_human_bytes(sys_page_size) << " memory pages" << std::endl;
+
+    const size_t total_memory{get_physical_memory()};
+    REQUIRE(total_memory > 0);
+    REQUIRE(get_physical_memory(/*available=*/true) <= total_memory);
 }
 
 static const void* last_lock_addr{nullptr};
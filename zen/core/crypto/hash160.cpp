@@ -10,7 +10,7 @@
 
 namespace zen::crypto {
 
-Hash160::Hash160() : Hasher(RIPEMD160_DIGEST_LENGTH, SHA256_CBLOCK) {}
+Hash160::Hash160(HasherPolicy policy) : Hasher(RIPEMD160_DIGEST_LENGTH, SHA256_CBLOCK, policy), hasher{policy} {}
 
 Hash160::Hash160(ByteView initial_data) : Hash160() { init(initial_data); }
 
@@ -26,11 +26,13 @@ void Hash160::update(ByteView data) noexcept { hasher.update(data); }
 
 void Hash160::update(std::string_view data) noexcept { hasher.update(data); }
 
-Bytes Hash160::finalize() noexcept {
-    SecureBytes buffer(hasher.digest_size(), 0);
-    buffer.assign(hasher.finalize());
-    Ripemd160 hasher2({&buffer[0], buffer.size()});
-    return hasher2.finalize();
+void Hash160::finalize(std::span<uint8_t> out) noexcept {
+    h256 digest;
+    hasher.finalize(digest);
+    Ripemd160 hasher2(policy());
+    hasher2.update({digest.data(), digest.size()});
+    hasher2.finalize(out);
+    if (policy() == HasherPolicy::kSecret) memory_cleanse(digest.data(), digest.size());
 }
 
 }  // namespace zen::crypto
@@ -9,12 +9,13 @@
 #include <boost/noncopyable.hpp>
 
 #include <zen/core/crypto/sha_2_256.hpp>
+#include <zen/core/types/hash.hpp>
 
 namespace zen::crypto {
 //! \brief A hasher class for Bitcoin's 160-bit hash (SHA-256 + RIPEMD-160)
 class Hash160 : public Hasher {
   public:
-    Hash160();
+    explicit Hash160(HasherPolicy policy = HasherPolicy::kPublic);
     ~Hash160() override = default;
 
     explicit Hash160(ByteView initial_data);
@@ -25,7 +26,9 @@ class Hash160 : public Hasher {
 
     void update(ByteView data) noexcept override;
     void update(std::string_view data) noexcept override;
-    [[nodiscard]] Bytes finalize() noexcept override;
+    using Hasher::finalize;
+    void finalize(std::span<uint8_t> out) noexcept override;
+    void finalize(h160& out) noexcept { finalize({out.data(), out.size()}); }
 
   private:
     Sha256 hasher;
@@ -4,12 +4,16 @@
    file COPYING or http://www.opensource.org/licenses/mit-license.php.
 */
 
+#include <algorithm>
+#include <array>
+
 #include <zen/core/common/cast.hpp>
 #include <zen/core/crypto/hash256.hpp>
+#include <zen/core/crypto/sha_2_256_transform.hpp>
 
 namespace zen::crypto {
 
-Hash256::Hash256() : Hasher(SHA256_DIGEST_LENGTH, SHA256_CBLOCK) {}
+Hash256::Hash256(HasherPolicy policy) : Hasher(SHA256_DIGEST_LENGTH, SHA256_CBLOCK, policy), hasher{policy} {}
 
 Hash256::Hash256(ByteView initial_data) : Hash256() { init(initial_data); }
 
@@ -25,12 +29,32 @@ void Hash256::update(ByteView data) noexcept { hasher.update(data); }
 
 void Hash256::update(std::string_view data) noexcept { hasher.update(data); }
 
-Bytes Hash256::finalize() noexcept {
-    SecureBytes buffer(hasher.digest_size(), 0);
-    buffer.assign(hasher.finalize());
+void Hash256::finalize(std::span<uint8_t> out) noexcept {
+    h256 digest;
+    hasher.finalize(digest);
     hasher.init();
-    hasher.update({&buffer[0], buffer.size()});
-    return hasher.finalize();
+    hasher.update({digest.data(), digest.size()});
+    hasher.finalize(out);
+    if (policy() == HasherPolicy::kSecret) memory_cleanse(digest.data(), digest.size());
+}
+
+void Hash256::hash_many(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept {
+    Sha256::hash_many(inputs, outputs);
+
+    // Second pass in place by chunks of views on the stack : each digest is read before being overwritten
+    static constexpr size_t kChunkSize{64};
+    std::array<ByteView, kChunkSize> digests;
+    for (size_t offset{0}; offset < outputs.size(); offset += kChunkSize) {
+        const auto chunk{outputs.subspan(offset, std::min(kChunkSize, outputs.size() - offset))};
+        for (size_t i{0}; i < chunk.size(); ++i) digests[i] = ByteView{chunk[i].data(), chunk[i].size()};
+        Sha256::hash_many({digests.data(), chunk.size()}, chunk);
+    }
 }
 
+void hash256_64(const uint8_t in[64], uint8_t out[32]) noexcept {
+    sha256::double_hash_64(in, out, 1, sha256::BatchMode::kSequential);
+}
+
+void hash256_64_many(const uint8_t* in, uint8_t* out, size_t count) noexcept { sha256::double_hash_64(in, out, count); }
+
 }  // namespace zen::crypto
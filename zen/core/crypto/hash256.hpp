@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <span>
+
 #include <boost/noncopyable.hpp>
 
 #include <zen/core/crypto/sha_2_256.hpp>
@@ -14,7 +16,7 @@ namespace zen::crypto {
 //! \brief A hasher class for Bitcoin's 256 bit hash (double Sha256)
 class Hash256 : public Hasher {
   public:
-    Hash256();
+    explicit Hash256(HasherPolicy policy = HasherPolicy::kPublic);
     ~Hash256() override = default;
 
     explicit Hash256(ByteView initial_data);
@@ -25,7 +27,12 @@ class Hash256 : public Hasher {
 
     void update(ByteView data) noexcept override;
     void update(std::string_view data) noexcept override;
-    [[nodiscard]] Bytes finalize() noexcept override;
+    using Hasher::finalize;
+    void finalize(std::span<uint8_t> out) noexcept override;
+    void finalize(h256& out) noexcept { finalize({out.data(), out.size()}); }
+
+    //! \brief Computes the double Sha256 digests of many independent messages at once (see Sha256::hash_many)
+    static void hash_many(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept;
 
   private:
     Sha256 hasher;
@@ -33,4 +40,12 @@ class Hash256 : public Hasher {
     void init_context() override{/* Need to override from parent class*/};
     void transform(const unsigned char*) override{/* Need to override from parent class*/};
 };
+
+//! \brief Bitcoin's 256 bit hash of exactly 64 bytes (e.g. the concatenation of two merkle nodes)
+//! \details No allocation nor virtual call : both padding blocks are precomputed constants
+void hash256_64(const uint8_t in[64], uint8_t out[32]) noexcept;
+
+//! \brief Same as hash256_64 for count consecutive 64 bytes inputs, interleaved in vector lanes when faster
+//! \remarks out may be the same as in (e.g. to reduce a merkle level in place)
+void hash256_64_many(const uint8_t* in, uint8_t* out, size_t count) noexcept;
 }  // namespace zen::crypto
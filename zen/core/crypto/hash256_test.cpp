@@ -4,12 +4,15 @@
    file COPYING or http://www.opensource.org/licenses/mit-license.php.
 */
 
+#include <cstring>
+#include <random>
 #include <vector>
 
 #include <catch2/catch.hpp>
 
 #include <zen/core/crypto/hash256.hpp>
 #include <zen/core/crypto/hasher_test.hpp>
+#include <zen/core/crypto/sha_2_256_transform.hpp>
 
 namespace zen::crypto {
 
@@ -36,4 +39,80 @@ TEST_CASE("Bitcoin Hash256", "[crypto]") {
     Hash256 hasher;
     run_hasher_tests(hasher, inputs, digests);
 }
+
+TEST_CASE("Bitcoin Hash256 into h256", "[crypto]") {
+    const std::string input{"abc"};
+    const auto expected{
+        *h256::from_hex(hex::reverse_hex("58636c3ec08c12d55aedda056d602d5bcca72d8df6a69b519b72d32dc2428b4f"))};
+
+    for (const auto policy : {HasherPolicy::kPublic, HasherPolicy::kSecret}) {
+        Hash256 hasher(policy);
+        CHECK(hasher.policy() == policy);
+        hasher.update(input);
+        h256 digest;
+        hasher.finalize(digest);
+        CHECK(digest == expected);
+
+        // Reusable after init
+        hasher.init();
+        hasher.update(input);
+        CHECK(h256(hasher.finalize()) == expected);
+    }
+}
+
+TEST_CASE("Bitcoin Hash256 hash many", "[crypto]") {
+    std::vector<Bytes> messages;
+    for (size_t i{0}; i < 20; ++i) {
+        messages.emplace_back(64, static_cast<uint8_t>(i));      // Merkle nodes
+        messages.emplace_back(80, static_cast<uint8_t>(i));      // Headers
+        messages.emplace_back(i * 13, static_cast<uint8_t>(i));  // Anything else
+    }
+    std::vector<ByteView> inputs(messages.begin(), messages.end());
+
+    std::vector<h256> digests(inputs.size());
+    Hash256::hash_many(inputs, digests);
+    for (size_t i{0}; i < inputs.size(); ++i) {
+        Hash256 hasher(inputs[i]);
+        CHECK(digests[i] == h256(hasher.finalize()));
+    }
+}
+
+TEST_CASE("Bitcoin Hash256 of 64 bytes", "[crypto]") {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint32_t> uni(0, 255);
+    static constexpr size_t kCount{21};  // Not a multiple of lanes
+    Bytes input(kCount * 64, 0);
+    for (auto& b : input) b = static_cast<uint8_t>(uni(rng));
+
+    Bytes expected(kCount * 32, 0);
+    for (size_t i{0}; i < kCount; ++i) {
+        Hash256 hasher(ByteView(&input[i * 64], 64));
+        const auto digest{hasher.finalize()};
+        std::memcpy(&expected[i * 32], digest.data(), digest.size());
+    }
+
+    Bytes output(32, 0);
+    hash256_64(input.data(), output.data());
+    CHECK(output == expected.substr(0, 32));
+
+    output.assign(kCount * 32, 0);
+    hash256_64_many(input.data(), output.data(), kCount);
+    CHECK(output == expected);
+
+    for (const auto mode : {sha256::BatchMode::kSequential, sha256::BatchMode::kLanes4, sha256::BatchMode::kLanes8}) {
+        if (!sha256::is_supported(mode)) continue;
+        INFO("Batch mode " << sha256::to_string(mode));
+        for (const size_t count : {size_t{0}, size_t{1}, size_t{4}, size_t{9}, kCount}) {
+            output.assign(kCount * 32, 0);
+            sha256::double_hash_64(input.data(), output.data(), count, mode);
+            CHECK(output.substr(0, count * 32) == expected.substr(0, count * 32));
+        }
+
+        // In place
+        Bytes in_place{input};
+        sha256::double_hash_64(in_place.data(), in_place.data(), kCount, mode);
+        CHECK(in_place.substr(0, kCount * 32) == expected);
+    }
+}
+
 }  // namespace zen::crypto
@@ -5,29 +5,65 @@
 */
 
 #include <zen/core/common/cast.hpp>
+#include <zen/core/common/endian.hpp>
 #include <zen/core/crypto/hasher.hpp>
 
 namespace zen::crypto {
 
+Hasher::Hasher(size_t _digest_size, size_t _block_size, HasherPolicy _policy)
+    : digest_size_{_digest_size}, block_size_{_block_size}, policy_{_policy} {
+    ZEN_ASSERT(block_size_ <= kMaxBlockSize);
+    lock_context(buffer_);
+}
+
+Hasher::~Hasher() { unlock_context(buffer_); }
+
+Bytes Hasher::finalize() noexcept {
+    Bytes ret(digest_size_, '\0');
+    finalize(std::span<uint8_t>{ret.data(), ret.size()});
+    return ret;
+}
+
+void Hasher::reset_buffer() noexcept {
+    if (policy_ == HasherPolicy::kSecret) memory_cleanse(buffer_.data(), buffer_.size());
+    buffer_offset_ = 0;
+    total_bytes_ = 0;
+}
+
+void Hasher::append_padding(size_t length_size, bool little_endian_length) noexcept {
+    static constexpr std::array<uint8_t, kMaxBlockSize> pad{0x80};
+    std::array<uint8_t, 2 * sizeof(uint64_t)> length{};
+    ZEN_ASSERT(length_size <= length.size() && length_size >= sizeof(uint64_t));
+    if (little_endian_length) {
+        endian::store_little_u64(&length[0], total_bytes_ << 3);
+    } else {
+        endian::store_big_u64(&length[length_size - sizeof(uint64_t)], total_bytes_ << 3);
+    }
+    const size_t modulo{total_bytes_ % block_size_};
+    update({&pad[0], 1 + ((2 * block_size_ - length_size - 1 - modulo) % block_size_)});
+    update({&length[0], length_size});
+}
+
 void Hasher::update(ByteView data) noexcept {
     // If some room left in buffer fill it
     if (buffer_offset_ != 0) {
-        const size_t room_size{std::min(buffer_.size() - buffer_offset_, data.size())};
+        const size_t room_size{std::min(block_size_ - buffer_offset_, data.size())};
         memcpy(&buffer_[buffer_offset_], data.data(), room_size);
         data.remove_prefix(room_size);  // Already consumed
         buffer_offset_ += room_size;
         total_bytes_ += room_size;
-        if (buffer_offset_ == buffer_.size()) {
+        if (buffer_offset_ == block_size_) {
             transform(buffer_.data());
             buffer_offset_ = 0;
         }
     }
 
-    // Process remaining data in chunks
-    while (data.size() >= block_size_) {
-        total_bytes_ += block_size_;
-        transform(data.data());
-        data.remove_prefix(block_size_);
+    // Process remaining whole blocks in one go
+    if (const size_t num_blocks{data.size() / block_size_}; num_blocks != 0) {
+        const size_t blocks_size{num_blocks * block_size_};
+        transform_blocks(data.data(), num_blocks);
+        total_bytes_ += blocks_size;
+        data.remove_prefix(blocks_size);
     }
 
     // Accumulate leftover in buffer
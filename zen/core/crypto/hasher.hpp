@@ -6,6 +6,7 @@
 
 #pragma once
 #include <array>
+#include <span>
 
 #include <boost/noncopyable.hpp>
 #include <openssl/ripemd.h>
@@ -13,8 +14,7 @@
 
 #include <zen/core/common/assert.hpp>
 #include <zen/core/common/base.hpp>
-#include <zen/core/common/object_pool.hpp>
-#include <zen/core/common/secure_bytes.hpp>
+#include <zen/core/common/memory.hpp>
 
 namespace zen::crypto {
 
@@ -23,21 +23,37 @@ class Sha256;     // See sha_256.?pp
 class Sha512;     // See sha_512.?pp
 class Ripemd160;  // See ripemd.?pp
 
+//! \brief How a hasher treats its state (context and block buffer)
+enum class HasherPolicy {
+    kPublic,  // Public data (e.g. chain data) : nothing on top of hashing
+    kSecret,  // Key material : state is locked against page-out and wiped out on init and destruction
+};
+
 //! \brief A wrapper around OpenSSL's Hashing functions
+//! \details Context and block buffer live inside the object hence a hasher on the stack never allocates
 class Hasher : private boost::noncopyable {
   public:
-    Hasher(size_t _digest_size, size_t _block_size)
-        : digest_size_{_digest_size}, block_size_{_block_size}, buffer_(_block_size, 0x0){};
-    virtual ~Hasher() = default;
+    //! \brief The largest block size among implemented hashers (SHA-512)
+    static constexpr size_t kMaxBlockSize{SHA512_CBLOCK};
+
+    Hasher(size_t _digest_size, size_t _block_size, HasherPolicy _policy = HasherPolicy::kPublic);
+    virtual ~Hasher();
 
     [[nodiscard]] constexpr size_t digest_size() const { return digest_size_; };
     [[nodiscard]] constexpr size_t block_size() const { return block_size_; };
+    [[nodiscard]] constexpr HasherPolicy policy() const { return policy_; };
 
     virtual void init() noexcept = 0;
     void reset() noexcept { init(); }  // Alias
     virtual void update(ByteView data) noexcept;
     virtual void update(std::string_view data) noexcept;
-    [[nodiscard]] virtual Bytes finalize() noexcept = 0;
+
+    //! \brief Writes the digest into out
+    //! \remarks out must be at least digest_size() bytes
+    virtual void finalize(std::span<uint8_t> out) noexcept = 0;
+
+    //! \brief Returns the digest in a newly allocated buffer
+    [[nodiscard]] Bytes finalize() noexcept;
 
   private:
     friend class Sha1;
@@ -47,12 +63,37 @@ class Hasher : private boost::noncopyable {
 
     const size_t digest_size_;
     const size_t block_size_;
-    SecureBytes buffer_;
+    const HasherPolicy policy_;
+    std::array<uint8_t, kMaxBlockSize> buffer_{};
     size_t buffer_offset_{0};
     size_t total_bytes_{0};
 
     virtual void init_context() = 0;
     virtual void transform(const unsigned char* data) = 0;
+
+    //! \brief Processes num_blocks consecutive blocks. Hashers able to process many blocks in one go override this
+    virtual void transform_blocks(const unsigned char* data, size_t num_blocks) {
+        for (; num_blocks != 0; --num_blocks, data += block_size_) transform(data);
+    }
+
+    //! \brief Empties the block buffer (wiping it out with kSecret policy)
+    void reset_buffer() noexcept;
+
+    //! \brief Appends the 0x80 byte, the zeroes and the message length in bits (on length_size bytes) which close
+    //! the last block
+    void append_padding(size_t length_size, bool little_endian_length) noexcept;
+
+    //! \brief Locks the memory of a hasher context with kSecret policy
+    template <typename T>
+    void lock_context(const T& context) const noexcept {
+        if (policy_ == HasherPolicy::kSecret) std::ignore = lock_object_memory(context);
+    }
+
+    //! \brief Wipes out and unlocks the memory of a hasher context with kSecret policy
+    template <typename T>
+    void unlock_context(const T& context) const noexcept {
+        if (policy_ == HasherPolicy::kSecret) std::ignore = unlock_object_memory(context);
+    }
 };
 
 }  // namespace zen::crypto
@@ -4,18 +4,37 @@
    file COPYING or http://www.opensource.org/licenses/mit-license.php.
 */
 
+#include <array>
+#include <string>
+#include <vector>
+
 #include <benchmark/benchmark.h>
+#include <cmd/benchmark/allocation_counter.hpp>
 
 #include <zen/core/common/base.hpp>
 #include <zen/core/common/cast.hpp>
 #include <zen/core/common/misc.hpp>
+#include <zen/core/crypto/hash160.hpp>
+#include <zen/core/crypto/hash256.hpp>
 #include <zen/core/crypto/sha_1.hpp>
 #include <zen/core/crypto/sha_2_256.hpp>
 #include <zen/core/crypto/sha_2_256_old.hpp>
+#include <zen/core/crypto/sha_2_256_transform.hpp>
 #include <zen/core/crypto/sha_2_512.hpp>
 
 namespace zen {
 static constexpr size_t kInputSize{4_KiB};
+static constexpr size_t kBatchSize{4'096};  // Messages per batch
+
+//! \brief Returns kBatchSize random messages of the given size
+static std::vector<Bytes> make_batch(size_t message_size) {
+    std::vector<Bytes> ret;
+    ret.reserve(kBatchSize);
+    for (size_t i{0}; i < kBatchSize; ++i) {
+        ret.emplace_back(string_view_to_byte_view(zen::get_random_alpha_string(message_size)));
+    }
+    return ret;
+}
 
 void bench_sha1(benchmark::State& state) {
     using namespace zen;
@@ -70,6 +89,152 @@ void bench_sha256_old(benchmark::State& state) {
     }
 }
 
+void bench_sha256_backend(benchmark::State& state, crypto::sha256::Backend backend) {
+    using namespace zen;
+    const auto transform{crypto::sha256::transform_function(backend)};
+    if (!transform) {
+        state.SkipWithError("Backend not supported by this CPU");
+        return;
+    }
+    int bytes_processed{0};
+    int items_processed{0};
+    const std::string input{zen::get_random_alpha_string(kInputSize)};
+    const auto input_view{string_view_to_byte_view(input)};
+    for ([[maybe_unused]] auto _ : state) {
+        auto hash_state{crypto::sha256::kInitialState};
+        transform(hash_state.data(), input_view.data(), kInputSize / 64);  // All blocks in one call
+        benchmark::DoNotOptimize(hash_state);
+        bytes_processed += static_cast<int>(input.size());
+        ++items_processed;
+        state.SetBytesProcessed(bytes_processed);
+        state.SetItemsProcessed(items_processed);
+    }
+}
+
+void bench_sha256_one_by_one(benchmark::State& state) {
+    using namespace zen;
+    const auto messages{make_batch(static_cast<size_t>(state.range(0)))};
+    crypto::Sha256 hasher;
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto& message : messages) {
+            hasher.init();
+            hasher.update(message);
+            auto digest{hasher.finalize()};
+            benchmark::DoNotOptimize(digest);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatchSize));
+}
+
+void bench_sha256_hash_many(benchmark::State& state, crypto::sha256::BatchMode mode) {
+    using namespace zen;
+    if (!crypto::sha256::is_supported(mode)) {
+        state.SkipWithError("Batch mode not supported by this CPU");
+        return;
+    }
+    const auto messages{make_batch(static_cast<size_t>(state.range(0)))};
+    const std::vector<ByteView> inputs(messages.begin(), messages.end());
+    std::vector<h256> outputs(inputs.size());
+    for ([[maybe_unused]] auto _ : state) {
+        crypto::sha256::hash_many(inputs, outputs, mode);
+        benchmark::DoNotOptimize(outputs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatchSize));
+}
+
+void bench_hash256_hash_many(benchmark::State& state) {
+    using namespace zen;
+    const auto messages{make_batch(static_cast<size_t>(state.range(0)))};
+    const std::vector<ByteView> inputs(messages.begin(), messages.end());
+    std::vector<h256> outputs(inputs.size());
+    const auto allocations_before{allocations_count()};
+    for ([[maybe_unused]] auto _ : state) {
+        crypto::Hash256::hash_many(inputs, outputs);
+        benchmark::DoNotOptimize(outputs.data());
+    }
+    state.counters["allocs_per_batch"] = benchmark::Counter(
+        static_cast<double>(allocations_count() - allocations_before), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatchSize));
+}
+
+void bench_hash256_64_hasher(benchmark::State& state) {
+    using namespace zen;
+    const auto input{make_batch(64)};
+    crypto::Hash256 hasher;
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto& message : input) {
+            hasher.init(message);
+            auto digest{hasher.finalize()};
+            benchmark::DoNotOptimize(digest);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatchSize));
+}
+
+void bench_hash256_64(benchmark::State& state) {
+    using namespace zen;
+    const auto input{make_batch(64)};
+    h256 digest;
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto& message : input) {
+            crypto::hash256_64(message.data(), digest.data());
+            benchmark::DoNotOptimize(digest);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatchSize));
+}
+
+void bench_hash256_64_many(benchmark::State& state, crypto::sha256::BatchMode mode) {
+    using namespace zen;
+    if (!crypto::sha256::is_supported(mode)) {
+        state.SkipWithError("Batch mode not supported by this CPU");
+        return;
+    }
+    const auto input{zen::get_random_alpha_string(kBatchSize * 64)};
+    const Bytes inputs(string_view_to_byte_view(input));
+    Bytes outputs(kBatchSize * 32, 0);
+    for ([[maybe_unused]] auto _ : state) {
+        crypto::sha256::double_hash_64(inputs.data(), outputs.data(), kBatchSize, mode);
+        benchmark::DoNotOptimize(outputs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kBatchSize));
+}
+
+//! \brief Hashes a message with a hasher on the stack and the digest written into a caller's buffer
+template <class HasherType, class Digest>
+void bench_hasher_into_digest(benchmark::State& state) {
+    using namespace zen;
+    const auto input{make_batch(static_cast<size_t>(state.range(0))).front()};
+    Digest digest{};
+    const auto allocations_before{allocations_count()};
+    for ([[maybe_unused]] auto _ : state) {
+        HasherType hasher;
+        hasher.update(input);
+        hasher.finalize(digest);
+        benchmark::DoNotOptimize(digest.data());
+    }
+    state.counters["allocs_per_hash"] = benchmark::Counter(
+        static_cast<double>(allocations_count() - allocations_before), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations());
+}
+
+//! \brief Same as above but with the digest returned in a newly allocated buffer
+template <class HasherType>
+void bench_hasher_to_bytes(benchmark::State& state) {
+    using namespace zen;
+    const auto input{make_batch(static_cast<size_t>(state.range(0))).front()};
+    const auto allocations_before{allocations_count()};
+    for ([[maybe_unused]] auto _ : state) {
+        HasherType hasher;
+        hasher.update(input);
+        const auto digest{hasher.finalize()};
+        benchmark::DoNotOptimize(digest.data());
+    }
+    state.counters["allocs_per_hash"] = benchmark::Counter(
+        static_cast<double>(allocations_count() - allocations_before), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations());
+}
+
 void bench_sha512(benchmark::State& state) {
     using namespace zen;
     int bytes_processed{0};
@@ -90,6 +255,26 @@ void bench_sha512(benchmark::State& state) {
 BENCHMARK(bench_sha1)->Arg(10'000);
 BENCHMARK(bench_sha256)->Arg(10'000);
 BENCHMARK(bench_sha256_old)->Arg(10'000);
+BENCHMARK_CAPTURE(bench_sha256_backend, generic, crypto::sha256::Backend::kGeneric);
+BENCHMARK_CAPTURE(bench_sha256_backend, sse41, crypto::sha256::Backend::kSse41);
+BENCHMARK_CAPTURE(bench_sha256_backend, avx2, crypto::sha256::Backend::kAvx2);
+BENCHMARK_CAPTURE(bench_sha256_backend, shani, crypto::sha256::Backend::kShaNi);
+BENCHMARK(bench_sha256_one_by_one)->Arg(64)->Arg(80);
+BENCHMARK_CAPTURE(bench_sha256_hash_many, sequential, crypto::sha256::BatchMode::kSequential)->Arg(64)->Arg(80);
+BENCHMARK_CAPTURE(bench_sha256_hash_many, lanes4, crypto::sha256::BatchMode::kLanes4)->Arg(64)->Arg(80);
+BENCHMARK_CAPTURE(bench_sha256_hash_many, lanes8, crypto::sha256::BatchMode::kLanes8)->Arg(64)->Arg(80);
+BENCHMARK(bench_hash256_hash_many)->Arg(64)->Arg(80);
+BENCHMARK(bench_hash256_64_hasher);
+BENCHMARK(bench_hash256_64);
+BENCHMARK_CAPTURE(bench_hash256_64_many, sequential, crypto::sha256::BatchMode::kSequential);
+BENCHMARK_CAPTURE(bench_hash256_64_many, lanes4, crypto::sha256::BatchMode::kLanes4);
+BENCHMARK_CAPTURE(bench_hash256_64_many, lanes8, crypto::sha256::BatchMode::kLanes8);
 BENCHMARK(bench_sha512)->Arg(10'000);
+BENCHMARK_TEMPLATE(bench_hasher_into_digest, crypto::Sha256, h256)->Arg(64)->Arg(80);
+BENCHMARK_TEMPLATE(bench_hasher_into_digest, crypto::Hash256, h256)->Arg(64)->Arg(80);
+BENCHMARK_TEMPLATE(bench_hasher_into_digest, crypto::Hash160, h160)->Arg(33)->Arg(65);
+BENCHMARK_TEMPLATE(bench_hasher_into_digest, crypto::Sha512, std::array<uint8_t, 64>)->Arg(64);
+BENCHMARK_TEMPLATE(bench_hasher_to_bytes, crypto::Sha256)->Arg(64)->Arg(80);
+BENCHMARK_TEMPLATE(bench_hasher_to_bytes, crypto::Hash256)->Arg(64)->Arg(80);
 
 }  // namespace zen
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <random>
+#include <span>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -39,6 +40,13 @@ void run_hasher_tests(Hasher& hasher, const std::vector<std::string>& inputs, co
         const auto hash{hasher.finalize()};
         CHECK(hash.size() == hasher.digest_size());
         CHECK(zen::hex::encode(hash) == digests[i]);
+
+        // Same into a caller supplied buffer
+        hasher.init();
+        hasher.update(string_view_to_byte_view(inputs[i]));
+        Bytes digest(hasher.digest_size(), '\0');
+        hasher.finalize(std::span<uint8_t>{digest.data(), digest.size()});
+        CHECK(digest == hash);
     }
 }
 
@@ -68,6 +76,14 @@ void run_hasher_tests(Hasher& hasher, const std::vector<std::pair<std::string, s
 
         const auto hash{hasher.finalize()};
         CHECK(hash.size() == hasher.digest_size());
+
+        // Same into a caller supplied buffer
+        hasher.init(initial_key);
+        hasher.update(input);
+        Bytes digest(hasher.digest_size(), '\0');
+        hasher.finalize(std::span<uint8_t>{digest.data(), digest.size()});
+        CHECK(digest == hash);
+
         const auto hexed_hash{zen::hex::encode(hash)};
         if (digests[i].length() < hexed_hash.length()) {
             CHECK(hexed_hash.substr(0, digests[i].size()) == digests[i]);
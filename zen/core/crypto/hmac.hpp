@@ -5,6 +5,10 @@
 */
 
 #pragma once
+#include <array>
+#include <cstring>
+#include <span>
+
 #include <boost/noncopyable.hpp>
 
 #include <zen/core/common/cast.hpp>
@@ -30,26 +34,27 @@ class Hmac : private boost::noncopyable {
         inner.init();
         outer.init();
 
-        Bytes rkey;
-        rkey.reserve(inner.block_size());
+        // Key material : kept on the stack and wiped out once the pads are absorbed
+        std::array<uint8_t, Hasher::kMaxBlockSize> rkey{};
+        const std::span<uint8_t> key{rkey.data(), inner.block_size()};
         if (initial_data.length() > inner.block_size()) {
             inner.update(initial_data);
-            rkey.assign(inner.finalize());
+            inner.finalize(key);
             inner.init();  // Reset
         } else {
-            rkey.assign(initial_data);
+            std::memcpy(key.data(), initial_data.data(), initial_data.length());
         }
-        rkey.resize(inner.block_size(), 0);
 
-        for (size_t i{0}; i < rkey.size(); ++i) {
-            rkey[i] ^= 0x5c;
+        for (auto& b : key) {
+            b ^= 0x5c;
         }
-        outer.update(rkey);
+        outer.update({key.data(), key.size()});
 
-        for (size_t i{0}; i < rkey.size(); ++i) {
-            rkey[i] ^= 0x5c ^ 0x36;
+        for (auto& b : key) {
+            b ^= 0x5c ^ 0x36;
         }
-        inner.update(rkey);
+        inner.update({key.data(), key.size()});
+        memory_cleanse(rkey.data(), rkey.size());
     };
 
     void init(const std::string_view initial_data) { init(string_view_to_byte_view(initial_data)); };
@@ -57,14 +62,24 @@ class Hmac : private boost::noncopyable {
     void update(ByteView data) noexcept { inner.update(data); };
     void update(std::string_view data) noexcept { inner.update(data); };
 
+    //! \brief Writes the digest into out (at least digest_size() bytes)
+    void finalize(std::span<uint8_t> out) noexcept {
+        std::array<uint8_t, Hasher::kMaxBlockSize> digest{};
+        inner.finalize(digest);
+        outer.update({digest.data(), inner.digest_size()});
+        outer.finalize(out);
+        memory_cleanse(digest.data(), digest.size());
+    };
+
     Bytes finalize() {
-        outer.update(inner.finalize());
-        return outer.finalize();
+        Bytes ret(digest_size(), '\0');
+        finalize({ret.data(), ret.size()});
+        return ret;
     };
 
   private:
-    SHA2_SIZE inner{};
-    SHA2_SIZE outer{};
+    SHA2_SIZE inner{HasherPolicy::kSecret};
+    SHA2_SIZE outer{HasherPolicy::kSecret};
 };
 
 using Hmac256 = Hmac<Sha256>;
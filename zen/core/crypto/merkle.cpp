@@ -0,0 +1,158 @@
+/*
+   Copyright 2009-2010 Satoshi Nakamoto
+   Copyright 2009-2015 The Bitcoin Core developers
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <thread>
+
+#include <zen/core/crypto/hash256.hpp>
+#include <zen/core/crypto/merkle.hpp>
+
+namespace zen::crypto {
+
+static_assert(sizeof(h256) == h256::size(), "Nodes of a level must be contiguous");
+
+namespace {
+
+    //! \brief A leaf whose branch is being collected
+    struct TrackedNode {
+        size_t position{0};  // Position in the current level
+        std::vector<h256>* branch{nullptr};
+    };
+
+    //! \brief Reduces nodes in place by height levels (or down to a single node when no height is given) collecting
+    //! the siblings of the tracked nodes
+    //! \return Whether two identical nodes have been paired
+    bool reduce(std::vector<h256>& nodes, std::optional<size_t> height, std::span<TrackedNode> tracked) {
+        bool mutated{false};
+        for (size_t level{0}; height ? level < *height : nodes.size() > 1; ++level) {
+            for (size_t i{0}; i + 1 < nodes.size(); i += 2) {
+                mutated |= (nodes[i] == nodes[i + 1]);
+            }
+            if (nodes.size() % 2 != 0) nodes.push_back(nodes.back());
+            for (auto& node : tracked) {
+                node.branch->push_back(nodes[node.position ^ 1U]);
+                node.position >>= 1;
+            }
+            const auto num_pairs{nodes.size() / 2};
+            hash256_64_many(nodes.front().data(), nodes.front().data(), num_pairs);
+            nodes.resize(num_pairs);
+        }
+        return mutated;
+    }
+
+    size_t threads_for(size_t num_leaves, const MerkleConfig& config) noexcept {
+        size_t max_threads{config.max_threads};
+        if (max_threads == 0) max_threads = std::max(std::thread::hardware_concurrency(), 1U);
+        const auto min_leaves{std::max(config.min_leaves_per_thread, size_t{1})};
+        return std::clamp(num_leaves / min_leaves, size_t{1}, max_threads);
+    }
+
+}  // namespace
+
+MerkleResult compute_merkle(std::span<const h256> leaves, std::span<const size_t> proof_indices,
+                            const MerkleConfig& config) {
+    MerkleResult ret;
+    ret.proofs.resize(proof_indices.size());
+    for (size_t i{0}; i < proof_indices.size(); ++i) ret.proofs[i].index = proof_indices[i];
+    if (leaves.empty()) return ret;
+
+    // Width of the subtrees : a power of 2 so that each level of a subtree is made of pairs of the whole level
+    // and the last subtree (possibly narrower) gets its last node duplicated exactly when the whole level does
+    const auto num_threads{threads_for(leaves.size(), config)};
+    const auto width{std::bit_ceil((leaves.size() + num_threads - 1) / num_threads)};
+    const auto num_subtrees{(leaves.size() + width - 1) / width};
+
+    std::vector<std::vector<TrackedNode>> tracked(num_subtrees);
+    for (auto& proof : ret.proofs) {
+        if (proof.index >= leaves.size()) continue;
+        proof.branch.reserve(static_cast<size_t>(std::bit_width(leaves.size())));
+        tracked[proof.index / width].push_back({proof.index % width, &proof.branch});
+    }
+
+    std::vector<h256> top_nodes(num_subtrees);
+    std::vector<uint8_t> subtree_mutated(num_subtrees, 0);
+    const auto reduce_subtree{[&](size_t subtree) {
+        const auto subtree_leaves{leaves.subspan(subtree * width, std::min(width, leaves.size() - subtree * width))};
+        std::vector<h256> nodes;
+        nodes.reserve(subtree_leaves.size() + 1);
+        nodes.assign(subtree_leaves.begin(), subtree_leaves.end());
+        std::optional<size_t> height;
+        if (num_subtrees > 1) height = static_cast<size_t>(std::countr_zero(width));
+        subtree_mutated[subtree] = reduce(nodes, height, tracked[subtree]) ? 1 : 0;
+        top_nodes[subtree] = nodes.front();
+    }};
+
+    // Errors are collected per subtree and rethrown once all threads are joined
+    std::vector<std::exception_ptr> subtree_errors(num_subtrees);
+    const auto run_subtree{[&](size_t subtree) {
+        try {
+            reduce_subtree(subtree);
+        } catch (...) {
+            subtree_errors[subtree] = std::current_exception();
+        }
+    }};
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_subtrees - 1);
+    size_t next_subtree{1};
+    try {
+        for (; next_subtree < num_subtrees; ++next_subtree) {
+            threads.emplace_back(run_subtree, next_subtree);
+        }
+    } catch (...) {
+        // Out of threads (e.g. resource limits) or memory : the remaining subtrees are reduced by the calling thread
+    }
+    run_subtree(0);
+    for (; next_subtree < num_subtrees; ++next_subtree) run_subtree(next_subtree);
+    for (auto& thread : threads) thread.join();
+    for (const auto& error : subtree_errors) {
+        if (error) std::rethrow_exception(error);
+    }
+
+    ret.mutated = std::ranges::any_of(subtree_mutated, [](uint8_t m) { return m != 0; });
+    if (num_subtrees > 1) {
+        std::vector<TrackedNode> top_tracked;
+        for (size_t subtree{0}; subtree < num_subtrees; ++subtree) {
+            for (const auto& node : tracked[subtree]) top_tracked.push_back({subtree, node.branch});
+        }
+        ret.mutated |= reduce(top_nodes, std::nullopt, top_tracked);
+    }
+    ret.root = top_nodes.front();
+    return ret;
+}
+
+h256 merkle_root(std::span<const h256> leaves, bool* mutated) {
+    auto result{compute_merkle(leaves)};
+    if (mutated) *mutated = result.mutated;
+    return result.root;
+}
+
+std::vector<h256> merkle_branch(std::span<const h256> leaves, size_t index) {
+    const size_t indices[]{index};
+    auto result{compute_merkle(leaves, indices)};
+    return std::move(result.proofs.front().branch);
+}
+
+h256 merkle_root_from_branch(const h256& leaf, std::span<const h256> branch, size_t index) noexcept {
+    uint8_t pair[2 * h256::size()];
+    h256 ret{leaf};
+    for (const auto& sibling : branch) {
+        const bool is_right{(index & 1U) != 0};
+        std::memcpy(&pair[is_right ? h256::size() : 0], ret.data(), h256::size());
+        std::memcpy(&pair[is_right ? 0 : h256::size()], sibling.data(), h256::size());
+        hash256_64(pair, ret.data());
+        index >>= 1;
+    }
+    return ret;
+}
+
+}  // namespace zen::crypto
@@ -0,0 +1,78 @@
+/*
+   Copyright 2009-2010 Satoshi Nakamoto
+   Copyright 2009-2015 The Bitcoin Core developers
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <zen/core/types/hash.hpp>
+
+/*
+   Bitcoin's merkle trees
+
+   Each level is made of the double Sha256 hashes of the consecutive pairs of nodes of the level below.
+   When a level has an odd number of nodes the last one is paired with itself :
+
+            ABCDEEEE             root
+           /        \
+        ABCD        EEEE
+       /    \      /
+      AB    CD    EE
+     / \   / \   /
+     A B   C D   E               leaves
+
+   This makes the trees {A,B,C,D,E} and {A,B,C,D,E,E} share the same root (CVE-2012-2459) : whoever computes a root
+   for validation purposes MUST reject the trees where two identical nodes are hashed together (i.e. mutated).
+*/
+
+namespace zen::crypto {
+
+//! \brief Tuning of the merkle engine
+struct MerkleConfig {
+    uint32_t max_threads{0};              // Upper bound to hashing threads (0 means one per hardware thread)
+    size_t min_leaves_per_thread{2'048};  // Smaller trees are entirely hashed by the calling thread
+};
+
+//! \brief The siblings of a leaf from the leaves level up to (excluded) the root
+struct MerkleProof {
+    size_t index{0};
+    std::vector<h256> branch{};
+};
+
+//! \brief The outcome of a merkle tree computation
+struct MerkleResult {
+    h256 root{};
+    bool mutated{false};                // Whether two identical nodes have been hashed together
+    std::vector<MerkleProof> proofs{};  // One per requested leaf index in the same order
+};
+
+//! \brief Computes the merkle root of leaves along with the branches of the requested leaves in the same pass
+//! \details Levels are reduced in place with batched double Sha256. Large trees are split into as many subtrees of
+//! the same (power of 2) width as there are threads : each subtree is reduced by its own thread then the calling
+//! thread reduces the subtrees roots
+//! \remarks An empty set of leaves has a zero root. An index out of range of leaves gets an empty branch. When no
+//! more threads can be created the remaining subtrees are reduced by the calling thread
+//! \throws std::bad_alloc when running out of memory
+[[nodiscard]] MerkleResult compute_merkle(std::span<const h256> leaves, std::span<const size_t> proof_indices = {},
+                                          const MerkleConfig& config = {});
+
+//! \brief Computes the merkle root of leaves
+//! \param [out] mutated : when not null is set to whether the tree is mutated (see CVE-2012-2459)
+[[nodiscard]] h256 merkle_root(std::span<const h256> leaves, bool* mutated = nullptr);
+
+//! \brief Returns the branch of the leaf at index
+[[nodiscard]] std::vector<h256> merkle_branch(std::span<const h256> leaves, size_t index);
+
+//! \brief Computes the root of the tree a leaf belongs to from its branch
+//! \remarks To check a proof compare the returned value with the expected root
+[[nodiscard]] h256 merkle_root_from_branch(const h256& leaf, std::span<const h256> branch, size_t index) noexcept;
+
+}  // namespace zen::crypto
@@ -0,0 +1,51 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <zen/core/crypto/merkle.hpp>
+
+namespace zen::crypto {
+
+namespace {
+    std::vector<h256> make_leaves(size_t count) {
+        std::mt19937_64 rng{count};
+        std::vector<h256> ret(count);
+        for (auto& leaf : ret) {
+            for (size_t i{0}; i < h256::size(); ++i) leaf.data()[i] = static_cast<uint8_t>(rng());
+        }
+        return ret;
+    }
+}  // namespace
+
+void bench_merkle_root(benchmark::State& state, uint32_t max_threads) {
+    const auto leaves{make_leaves(static_cast<size_t>(state.range(0)))};
+    const MerkleConfig config{.max_threads = max_threads};
+    for ([[maybe_unused]] auto _ : state) {
+        const auto result{compute_merkle(leaves, {}, config)};
+        benchmark::DoNotOptimize(result.root.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void bench_merkle_branches(benchmark::State& state) {
+    const auto leaves{make_leaves(static_cast<size_t>(state.range(0)))};
+    const std::vector<size_t> indices{0, leaves.size() / 2, leaves.size() - 1};
+    for ([[maybe_unused]] auto _ : state) {
+        const auto result{compute_merkle(leaves, indices)};
+        benchmark::DoNotOptimize(result.proofs.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_CAPTURE(bench_merkle_root, single_thread, 1U)->Arg(16)->Arg(2'000)->Arg(20'000);
+BENCHMARK_CAPTURE(bench_merkle_root, all_threads, 0U)->Arg(16)->Arg(2'000)->Arg(20'000);
+BENCHMARK(bench_merkle_branches)->Arg(2'000);
+
+}  // namespace zen::crypto
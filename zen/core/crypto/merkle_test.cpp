@@ -0,0 +1,155 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <random>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <zen/core/crypto/hash256.hpp>
+#include <zen/core/crypto/merkle.hpp>
+
+namespace zen::crypto {
+
+namespace {
+    // Straightforward implementation to compare with
+    h256 naive_merkle_root(std::vector<h256> nodes) {
+        if (nodes.empty()) return {};
+        while (nodes.size() > 1) {
+            if (nodes.size() % 2 != 0) nodes.push_back(nodes.back());
+            std::vector<h256> parents;
+            for (size_t i{0}; i < nodes.size(); i += 2) {
+                Hash256 hasher;
+                hasher.update(ByteView{nodes[i].data(), h256::size()});
+                hasher.update(ByteView{nodes[i + 1].data(), h256::size()});
+                parents.emplace_back(ByteView{hasher.finalize()});
+            }
+            nodes = std::move(parents);
+        }
+        return nodes.front();
+    }
+
+    std::vector<h256> random_leaves(size_t count) {
+        std::mt19937_64 rng{count};
+        std::vector<h256> ret(count);
+        for (auto& leaf : ret) {
+            for (size_t i{0}; i < h256::size(); ++i) leaf.data()[i] = static_cast<uint8_t>(rng());
+        }
+        return ret;
+    }
+
+    h256 from_display_hex(std::string_view hex) { return *h256::from_hex(hex::reverse_hex(hex)); }
+}  // namespace
+
+TEST_CASE("Merkle root", "[crypto]") {
+    SECTION("Empty and single leaf") {
+        bool mutated{true};
+        CHECK(merkle_root({}, &mutated) == h256{});
+        CHECK_FALSE(mutated);
+
+        const auto leaves{random_leaves(1)};
+        CHECK(merkle_root(leaves, &mutated) == leaves.front());
+        CHECK_FALSE(mutated);
+        CHECK(merkle_branch(leaves, 0).empty());
+    }
+
+    SECTION("Bitcoin block 100000") {
+        const std::vector<h256> txids{
+            from_display_hex("8c14f0db3df150123e6f3dbbf30f8b955a8249b62ac1d1ff16284aefa3d06d87"),
+            from_display_hex("fff2525b8931402dd09222c50775608f75787bd2b87e56995a7bdd30f79702c4"),
+            from_display_hex("6359f0868171b1d194cbee1af2f16ea598ae8fad666d9b012c8ed2b79a236ec4"),
+            from_display_hex("e9a66845e05d5abc0ad04ec80f774a7e585c6e8db975962d069a522137b80c1d"),
+        };
+        bool mutated{true};
+        CHECK(merkle_root(txids, &mutated) ==
+              from_display_hex("f3e94742aca4b5ef85488dc37c06c3282295ffec960994b2c0d5ac2a25a95766"));
+        CHECK_FALSE(mutated);
+    }
+
+    SECTION("Same as naive") {
+        for (size_t count{1}; count < 40; ++count) {
+            const auto leaves{random_leaves(count)};
+            bool mutated{true};
+            CHECK(merkle_root(leaves, &mutated) == naive_merkle_root(leaves));
+            CHECK_FALSE(mutated);
+        }
+    }
+
+    SECTION("Mutated trees (CVE-2012-2459)") {
+        auto leaves{random_leaves(5)};
+        bool mutated{true};
+        const auto root{merkle_root(leaves, &mutated)};
+        CHECK_FALSE(mutated);
+
+        // Duplicating the last leaf of an odd level yields the same root
+        leaves.push_back(leaves.back());
+        CHECK(merkle_root(leaves, &mutated) == root);
+        CHECK(mutated);
+
+        // Also on upper levels : {A,B,C,D,E,F} and {A,B,C,D,E,F,E,F} share the same root
+        leaves = random_leaves(6);
+        const auto root6{merkle_root(leaves, &mutated)};
+        CHECK_FALSE(mutated);
+        leaves.push_back(leaves[4]);
+        leaves.push_back(leaves[5]);
+        CHECK(merkle_root(leaves, &mutated) == root6);
+        CHECK(mutated);
+
+        // Identical leaves not paired together are fine
+        leaves = random_leaves(4);
+        leaves[2] = leaves[1];
+        CHECK(merkle_root(leaves, &mutated) == naive_merkle_root(leaves));
+        CHECK_FALSE(mutated);
+    }
+
+    SECTION("Branches") {
+        for (size_t count{1}; count < 40; ++count) {
+            const auto leaves{random_leaves(count)};
+            std::vector<size_t> indices(count + 1);
+            for (size_t i{0}; i < indices.size(); ++i) indices[i] = i;
+
+            const auto result{compute_merkle(leaves, indices)};
+            REQUIRE(result.proofs.size() == indices.size());
+            for (size_t i{0}; i < count; ++i) {
+                const auto& proof{result.proofs[i]};
+                CHECK(proof.index == i);
+                CHECK(proof.branch == merkle_branch(leaves, i));
+                CHECK(merkle_root_from_branch(leaves[i], proof.branch, i) == result.root);
+                if (i + 1 < count || i % 2 != 0) {
+                    // Unless paired with itself the position matters
+                    CHECK(merkle_root_from_branch(leaves[i], proof.branch, i ^ 1U) != result.root);
+                }
+            }
+            CHECK(result.proofs.back().branch.empty());  // Out of range
+        }
+    }
+
+    SECTION("Multi threaded") {
+        const MerkleConfig config{.max_threads = 4, .min_leaves_per_thread = 1};
+        for (const size_t count : {2U, 3U, 5U, 8U, 9U, 17U, 33U, 100U, 1'000U, 1'025U}) {
+            auto leaves{random_leaves(count)};
+            const std::vector<size_t> indices{0, count / 3, count - 1};
+
+            const auto expected{compute_merkle(leaves, indices)};
+            const auto result{compute_merkle(leaves, indices, config)};
+            CHECK(result.root == expected.root);
+            CHECK(result.root == naive_merkle_root(leaves));
+            CHECK_FALSE(result.mutated);
+            for (size_t i{0}; i < indices.size(); ++i) {
+                CHECK(result.proofs[i].branch == expected.proofs[i].branch);
+            }
+
+            // Mutation detected in any subtree and on top
+            leaves.push_back(leaves.back());
+            CHECK(compute_merkle(leaves, {}, config).mutated == (count % 2 != 0));
+            leaves.pop_back();
+            leaves[count - 1] = leaves[count - 2];
+            CHECK(compute_merkle(leaves, {}, config).mutated == (count % 2 == 0));
+        }
+    }
+}
+
+}  // namespace zen::crypto
@@ -7,23 +7,25 @@
 #pragma once
 
 #include <zen/core/crypto/hasher.hpp>
+#include <zen/core/types/hash.hpp>
 
 namespace zen::crypto {
 //! \brief A wrapper around OpenSSL's RIPEMD160 crypto functions
 class Ripemd160 : public Hasher {
   public:
-    Ripemd160();
+    explicit Ripemd160(HasherPolicy policy = HasherPolicy::kPublic);
     ~Ripemd160() override;
 
     explicit Ripemd160(ByteView initial_data);
     explicit Ripemd160(std::string_view initial_data);
 
     void init() noexcept override;
-    [[nodiscard]] Bytes finalize() noexcept override;
+    using Hasher::finalize;
+    void finalize(std::span<uint8_t> out) noexcept override;
+    void finalize(h160& out) noexcept { finalize({out.data(), out.size()}); }
 
   private:
-    std::unique_ptr<RIPEMD160_CTX> ctx_{nullptr};
-    static ZEN_THREAD_LOCAL ObjectPool<RIPEMD160_CTX> ctx_pool_;
+    RIPEMD160_CTX ctx_{};
 
     void init_context() override;
     void transform(const unsigned char* data) override;
@@ -12,19 +12,18 @@ namespace zen::crypto {
 //! \brief A wrapper around OpenSSL's SHA1 crypto functions
 class Sha1 final : public Hasher {
   public:
-    Sha1();
+    explicit Sha1(HasherPolicy policy = HasherPolicy::kPublic);
     ~Sha1() override;
 
     explicit Sha1(ByteView initial_data);
     explicit Sha1(std::string_view initial_data);
 
     void init() noexcept override;
-    [[nodiscard]] Bytes finalize() noexcept override;
-    [[nodiscard]] Bytes finalize_nopadding(bool compression) const noexcept;
+    using Hasher::finalize;
+    void finalize(std::span<uint8_t> out) noexcept override;
 
   private:
-    std::unique_ptr<SHA_CTX> ctx_{nullptr};
-    static ZEN_THREAD_LOCAL ObjectPool<SHA_CTX> ctx_pool_;
+    SHA_CTX ctx_{};
 
     void init_context() override;
     void transform(const unsigned char* data) override;
@@ -6,27 +6,39 @@
 
 #pragma once
 
+#include <span>
+
 #include <zen/core/crypto/hasher.hpp>
+#include <zen/core/types/hash.hpp>
 
 namespace zen::crypto {
-//! \brief A wrapper around OpenSSL's SHA256 crypto functions
+//! \brief SHA-256 hasher
+//! \details Blocks are processed by the fastest implementation supported by the CPU (see sha_2_256_transform.hpp)
 class Sha256 : public Hasher {
   public:
-    Sha256();
+    explicit Sha256(HasherPolicy policy = HasherPolicy::kPublic);
     ~Sha256() override;
 
     explicit Sha256(ByteView initial_data);
     explicit Sha256(std::string_view initial_data);
 
     void init() noexcept override;
-    [[nodiscard]] Bytes finalize() noexcept override;
+    using Hasher::finalize;
+    void finalize(std::span<uint8_t> out) noexcept override;
+    void finalize(h256& out) noexcept { finalize({out.data(), out.size()}); }
     [[nodiscard]] Bytes finalize_nopadding(bool compression) const noexcept;
 
+    //! \brief Computes the digests of many independent messages at once (see sha256::hash_many)
+    //! \details Faster than hashing each message with a hasher as messages are interleaved in vector lanes or, with
+    //! SHA extensions, hashed back to back with no buffering
+    static void hash_many(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept;
+
   private:
-    std::unique_ptr<SHA256_CTX> ctx_{nullptr};
-    static ZEN_THREAD_LOCAL ObjectPool<SHA256_CTX> ctx_pool_;
+    std::array<uint32_t, 8> state_{};
 
     void init_context() override;
+    void store_state(std::span<uint8_t> out) const noexcept;
     void transform(const unsigned char* data) override;
+    void transform_blocks(const unsigned char* data, size_t num_blocks) override;
 };
 }  // namespace zen::crypto
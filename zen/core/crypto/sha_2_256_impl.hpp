@@ -0,0 +1,84 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+
+// Internals of the SHA-256 backends (see sha_2_256_transform.hpp) : not meant to be included elsewhere
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define ZEN_SHA256_X86
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ZEN_SHA256_TARGET(features) __attribute__((target(features)))
+#else
+#define ZEN_SHA256_TARGET(features)
+#endif
+
+namespace zen::crypto::sha256 {
+
+//! \brief Round constants (FIPS 180-4 4.2.2)
+alignas(32) inline constexpr std::array<uint32_t, 64> kRoundConstants{
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
+
+//! \brief A message schedule with round constants already added (W[t] + K[t])
+using Schedule = std::array<uint32_t, 64>;
+
+inline constexpr uint32_t rotr(uint32_t x, int n) noexcept { return (x >> n) | (x << (32 - n)); }
+
+inline constexpr void round(uint32_t a, uint32_t b, uint32_t c, uint32_t& d, uint32_t e, uint32_t f, uint32_t g,
+                            uint32_t& h, uint32_t wk) noexcept {
+    const uint32_t t1{h + (rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25)) + (g ^ (e & (f ^ g))) + wk};
+    const uint32_t t2{(rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22)) + ((a & b) | (c & (a | b)))};
+    d += t1;
+    h = t1 + t2;
+}
+
+//! \brief Runs the 64 rounds of the compression function over a prepared schedule
+//! \remarks Shared by the backends which only differ in how the schedule is computed
+inline void compress(uint32_t* state, const Schedule& wk) noexcept {
+    uint32_t a{state[0]}, b{state[1]}, c{state[2]}, d{state[3]};
+    uint32_t e{state[4]}, f{state[5]}, g{state[6]}, h{state[7]};
+    for (size_t t{0}; t < 64; t += 8) {
+        round(a, b, c, d, e, f, g, h, wk[t]);
+        round(h, a, b, c, d, e, f, g, wk[t + 1]);
+        round(g, h, a, b, c, d, e, f, wk[t + 2]);
+        round(f, g, h, a, b, c, d, e, wk[t + 3]);
+        round(e, f, g, h, a, b, c, d, wk[t + 4]);
+        round(d, e, f, g, h, a, b, c, wk[t + 5]);
+        round(c, d, e, f, g, h, a, b, wk[t + 6]);
+        round(b, c, d, e, f, g, h, a, wk[t + 7]);
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void transform_generic(uint32_t* state, const uint8_t* blocks, size_t num_blocks);
+
+#if defined(ZEN_SHA256_X86)
+void transform_sse41(uint32_t* state, const uint8_t* blocks, size_t num_blocks);
+void transform_avx2(uint32_t* state, const uint8_t* blocks, size_t num_blocks);
+void transform_shani(uint32_t* state, const uint8_t* blocks, size_t num_blocks);
+#endif
+
+}  // namespace zen::crypto::sha256
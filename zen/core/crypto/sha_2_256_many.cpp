@@ -0,0 +1,336 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <cstring>
+
+#include <zen/core/common/assert.hpp>
+#include <zen/core/common/endian.hpp>
+#include <zen/core/crypto/sha_2_256_impl.hpp>
+#include <zen/core/crypto/sha_2_256_transform.hpp>
+
+// Lanes rely on GCC/Clang vector extensions : the same code becomes SSE2, AVX2 or NEON depending on the target of the
+// function it's inlined into
+#if defined(__GNUC__) || defined(__clang__)
+#define ZEN_SHA256_LANES
+#endif
+
+namespace zen::crypto::sha256 {
+
+namespace {
+
+    //! \brief The blocks of a message not wholly contained in its data (remainder, padding and length)
+    struct Tail {
+        std::array<uint8_t, 128> bytes{};
+        size_t num_blocks{0};
+    };
+
+    //! \brief Builds the padded tail of a message
+    //! \return The number of whole blocks of the message which can be processed straight from its data
+    size_t pad_message(ByteView message, Tail& tail) noexcept {
+        const size_t full_blocks{message.size() / 64};
+        const size_t remainder{message.size() % 64};
+        tail.num_blocks = remainder + 9 > 64 ? 2 : 1;
+        const size_t tail_size{tail.num_blocks * 64};
+        if (remainder) std::memcpy(tail.bytes.data(), &message[full_blocks * 64], remainder);
+        tail.bytes[remainder] = 0x80;
+        std::memset(&tail.bytes[remainder + 1], 0, tail_size - remainder - 9);
+        endian::store_big_u64(&tail.bytes[tail_size - 8], static_cast<uint64_t>(message.size()) << 3);
+        return full_blocks;
+    }
+
+    void store_digest(const uint32_t* state, h256& digest) noexcept {
+        for (size_t i{0}; i < 8; ++i) endian::store_big_u32(&digest.data()[i * 4], state[i]);
+    }
+
+    void hash_sequential(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept {
+        const TransformFunc transform_func{transform_function(best_backend())};
+        Tail tail;
+        for (size_t i{0}; i < inputs.size(); ++i) {
+            auto state{kInitialState};
+            const size_t full_blocks{pad_message(inputs[i], tail)};
+            if (full_blocks) transform_func(state.data(), inputs[i].data(), full_blocks);
+            transform_func(state.data(), tail.bytes.data(), tail.num_blocks);
+            store_digest(state.data(), outputs[i]);
+        }
+    }
+
+    //! \brief Padding block of a 64 bytes message (length is 512 bits)
+    constexpr std::array<uint8_t, 64> kPadding64{
+        0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,    0,
+        0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x02, 0x00};
+
+    //! \brief Second half of the only block of a 32 bytes message (a digest) : padding and length (256 bits)
+    constexpr std::array<uint8_t, 32> kPadding32{0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,    0,
+                                                 0,    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x01, 0x00};
+
+    void double_hash_64_sequential(const uint8_t* in, uint8_t* out, size_t count) noexcept {
+        const TransformFunc transform_func{transform_function(best_backend())};
+        std::array<uint8_t, 64> digest_block;
+        std::memcpy(&digest_block[32], kPadding32.data(), kPadding32.size());
+        for (; count != 0; --count, in += 64, out += 32) {
+            auto state{kInitialState};
+            transform_func(state.data(), in, 1);
+            transform_func(state.data(), kPadding64.data(), 1);
+            for (size_t i{0}; i < 8; ++i) endian::store_big_u32(&digest_block[i * 4], state[i]);
+            state = kInitialState;
+            transform_func(state.data(), digest_block.data(), 1);
+            for (size_t i{0}; i < 8; ++i) endian::store_big_u32(&out[i * 4], state[i]);
+        }
+    }
+
+#if defined(ZEN_SHA256_LANES)
+
+    using Lanes4 = uint32_t __attribute__((vector_size(16)));
+    using Lanes8 = uint32_t __attribute__((vector_size(32)));
+
+    //! \brief Compresses one block per lane : state[i] and w[t] hold the i-th state word and the t-th message word
+    //! of every lane. Words of w are overwritten by the message schedule
+    //! \remarks Rotations are spelled out as helpers returning 256 bit vectors would be ABI sensitive
+    template <class V>
+    [[gnu::always_inline]] inline void compress_words(V* state, V* w) noexcept {
+        V a{state[0]}, b{state[1]}, c{state[2]}, d{state[3]};
+        V e{state[4]}, f{state[5]}, g{state[6]}, h{state[7]};
+        for (size_t t{0}; t < 64; ++t) {
+            if (t >= 16) {
+                const V& w15{w[(t - 15) & 15]};
+                const V& w2{w[(t - 2) & 15]};
+                w[t & 15] += ((w15 >> 7 | w15 << 25) ^ (w15 >> 18 | w15 << 14) ^ (w15 >> 3)) + w[(t - 7) & 15] +
+                             ((w2 >> 17 | w2 << 15) ^ (w2 >> 19 | w2 << 13) ^ (w2 >> 10));
+            }
+            const V t1{h + ((e >> 6 | e << 26) ^ (e >> 11 | e << 21) ^ (e >> 25 | e << 7)) + (g ^ (e & (f ^ g))) +
+                       kRoundConstants[t] + w[t & 15]};
+            const V t2{((a >> 2 | a << 30) ^ (a >> 13 | a << 19) ^ (a >> 22 | a << 10)) + ((a & b) | (c & (a | b)))};
+            h = g;
+            g = f;
+            f = e;
+            e = d + t1;
+            d = c;
+            c = b;
+            b = a;
+            a = t1 + t2;
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+
+    //! \brief Compresses one block per lane
+    template <class V>
+    [[gnu::always_inline]] inline void compress_lanes(V* state, const uint8_t* const* blocks) noexcept {
+        constexpr size_t kLanes{sizeof(V) / sizeof(uint32_t)};
+        V w[16];
+        for (size_t t{0}; t < 16; ++t) {
+            for (size_t lane{0}; lane < kLanes; ++lane) w[t][lane] = endian::load_big_u32(&blocks[lane][t * 4]);
+        }
+        compress_words(state, w);
+    }
+
+    //! \brief A message being hashed in a lane
+    struct LaneJob {
+        size_t index{0};               // Position in inputs
+        const uint8_t* data{nullptr};  // Message data
+        size_t full_blocks{0};         // Blocks processed straight from data
+        size_t next_block{0};          // Next block to process
+        Tail tail;                     // Blocks processed from the tail
+        bool busy{false};              // Whether the lane is hashing a message
+    };
+
+    //! \brief Hashes messages in kLanes interleaved lanes, each refilled with the next message when done
+    template <class V>
+    [[gnu::always_inline]] inline void hash_lanes(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept {
+        constexpr size_t kLanes{sizeof(V) / sizeof(uint32_t)};
+        static constexpr std::array<uint8_t, 64> kIdleBlock{};  // Compressed by idle lanes (result ignored)
+
+        std::array<LaneJob, kLanes> jobs;
+        std::array<const uint8_t*, kLanes> blocks{};
+        V state[8]{};
+        size_t next_input{0};
+        size_t busy_lanes{0};
+
+        while (true) {
+            // Refill idle lanes
+            for (size_t lane{0}; lane < kLanes && next_input < inputs.size(); ++lane) {
+                auto& job{jobs[lane]};
+                if (job.busy) continue;
+                job.index = next_input++;
+                job.data = inputs[job.index].data();
+                job.full_blocks = pad_message(inputs[job.index], job.tail);
+                job.next_block = 0;
+                job.busy = true;
+                for (size_t i{0}; i < 8; ++i) state[i][lane] = kInitialState[i];
+                ++busy_lanes;
+            }
+            if (!busy_lanes) break;
+
+            for (size_t i{0}; i < kLanes; ++i) {
+                const auto& job{jobs[i]};
+                if (!job.busy) {
+                    blocks[i] = kIdleBlock.data();
+                } else if (job.next_block < job.full_blocks) {
+                    blocks[i] = &job.data[job.next_block * 64];
+                } else {
+                    blocks[i] = &job.tail.bytes[(job.next_block - job.full_blocks) * 64];
+                }
+            }
+            compress_lanes(state, blocks.data());
+
+            for (size_t i{0}; i < kLanes; ++i) {
+                auto& job{jobs[i]};
+                if (!job.busy || ++job.next_block < job.full_blocks + job.tail.num_blocks) continue;
+                std::array<uint32_t, 8> lane_state;
+                for (size_t j{0}; j < 8; ++j) lane_state[j] = state[j][i];
+                store_digest(lane_state.data(), outputs[job.index]);
+                job.busy = false;
+                --busy_lanes;
+            }
+        }
+    }
+
+    void hash_lanes4(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept {
+        hash_lanes<Lanes4>(inputs, outputs);
+    }
+
+    //! \brief Double hashes groups of kLanes 64 bytes messages, the remainder sequentially
+    //! \details The second and third blocks are known words (padding and first digest) hence no byte shuffling
+    template <class V>
+    [[gnu::always_inline]] inline void double_hash_64_lanes(const uint8_t* in, uint8_t* out, size_t count) noexcept {
+        constexpr size_t kLanes{sizeof(V) / sizeof(uint32_t)};
+        for (; count >= kLanes; count -= kLanes, in += 64 * kLanes, out += 32 * kLanes) {
+            V state[8];
+            V w[16];
+            for (size_t i{0}; i < 8; ++i) state[i] = V{} + kInitialState[i];
+            for (size_t t{0}; t < 16; ++t) {
+                for (size_t lane{0}; lane < kLanes; ++lane) w[t][lane] = endian::load_big_u32(&in[lane * 64 + t * 4]);
+            }
+            compress_words(state, w);
+            for (size_t t{0}; t < 16; ++t) w[t] = V{} + endian::load_big_u32(&kPadding64[t * 4]);
+            compress_words(state, w);
+
+            for (size_t i{0}; i < 8; ++i) {
+                w[i] = state[i];
+                w[i + 8] = V{} + endian::load_big_u32(&kPadding32[i * 4]);
+                state[i] = V{} + kInitialState[i];
+            }
+            compress_words(state, w);
+            for (size_t lane{0}; lane < kLanes; ++lane) {
+                for (size_t i{0}; i < 8; ++i) endian::store_big_u32(&out[lane * 32 + i * 4], state[i][lane]);
+            }
+        }
+        if (count != 0) double_hash_64_sequential(in, out, count);
+    }
+
+    void double_hash_64_lanes4(const uint8_t* in, uint8_t* out, size_t count) noexcept {
+        double_hash_64_lanes<Lanes4>(in, out, count);
+    }
+
+#if defined(ZEN_SHA256_X86)
+    ZEN_SHA256_TARGET("avx2")
+    void hash_lanes8(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept {
+        hash_lanes<Lanes8>(inputs, outputs);
+    }
+
+    ZEN_SHA256_TARGET("avx2") void double_hash_64_lanes8(const uint8_t* in, uint8_t* out, size_t count) noexcept {
+        double_hash_64_lanes<Lanes8>(in, out, count);
+    }
+#endif
+
+#endif  // ZEN_SHA256_LANES
+
+}  // namespace
+
+bool is_supported(BatchMode mode) noexcept {
+    switch (mode) {
+        case BatchMode::kSequential:
+            return true;
+#if defined(ZEN_SHA256_LANES)
+        case BatchMode::kLanes4:
+            return true;
+#if defined(ZEN_SHA256_X86)
+        case BatchMode::kLanes8:
+            return is_supported(Backend::kAvx2);
+#endif
+#endif
+        default:
+            return false;
+    }
+}
+
+BatchMode best_batch_mode() noexcept {
+    static const BatchMode mode{[] {
+        if (best_backend() == Backend::kShaNi) return BatchMode::kSequential;
+        for (const auto candidate : {BatchMode::kLanes8, BatchMode::kLanes4}) {
+            if (is_supported(candidate)) return candidate;
+        }
+        return BatchMode::kSequential;
+    }()};
+    return mode;
+}
+
+void hash_many(std::span<const ByteView> inputs, std::span<h256> outputs, BatchMode mode) noexcept {
+    ZEN_ASSERT(inputs.size() == outputs.size());
+    ZEN_ASSERT(is_supported(mode));
+    switch (mode) {
+#if defined(ZEN_SHA256_LANES)
+        case BatchMode::kLanes4:
+            hash_lanes4(inputs, outputs);
+            break;
+#if defined(ZEN_SHA256_X86)
+        case BatchMode::kLanes8:
+            hash_lanes8(inputs, outputs);
+            break;
+#endif
+#endif
+        default:
+            hash_sequential(inputs, outputs);
+            break;
+    }
+}
+
+void hash_many(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept {
+    hash_many(inputs, outputs, best_batch_mode());
+}
+
+void double_hash_64(const uint8_t* in, uint8_t* out, size_t count, BatchMode mode) noexcept {
+    ZEN_ASSERT(is_supported(mode));
+    switch (mode) {
+#if defined(ZEN_SHA256_LANES)
+        case BatchMode::kLanes4:
+            double_hash_64_lanes4(in, out, count);
+            break;
+#if defined(ZEN_SHA256_X86)
+        case BatchMode::kLanes8:
+            double_hash_64_lanes8(in, out, count);
+            break;
+#endif
+#endif
+        default:
+            double_hash_64_sequential(in, out, count);
+            break;
+    }
+}
+
+void double_hash_64(const uint8_t* in, uint8_t* out, size_t count) noexcept {
+    double_hash_64(in, out, count, best_batch_mode());
+}
+
+std::string_view to_string(BatchMode mode) noexcept {
+    switch (mode) {
+        case BatchMode::kSequential:
+            return "sequential";
+        case BatchMode::kLanes4:
+            return "lanes4";
+        case BatchMode::kLanes8:
+            return "lanes8";
+    }
+    return "unknown";
+}
+
+}  // namespace zen::crypto::sha256
@@ -0,0 +1,148 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <zen/core/common/endian.hpp>
+#include <zen/core/crypto/sha_2_256_impl.hpp>
+#include <zen/core/crypto/sha_2_256_transform.hpp>
+
+#if defined(ZEN_SHA256_X86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace zen::crypto::sha256 {
+
+void transform_generic(uint32_t* state, const uint8_t* blocks, size_t num_blocks) {
+    Schedule wk;
+    for (; num_blocks != 0; --num_blocks, blocks += 64) {
+        std::array<uint32_t, 64> w;
+        for (size_t t{0}; t < 16; ++t) w[t] = endian::load_big_u32(&blocks[t * 4]);
+        for (size_t t{16}; t < 64; ++t) {
+            const uint32_t s0{rotr(w[t - 15], 7) ^ rotr(w[t - 15], 18) ^ (w[t - 15] >> 3)};
+            const uint32_t s1{rotr(w[t - 2], 17) ^ rotr(w[t - 2], 19) ^ (w[t - 2] >> 10)};
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+        for (size_t t{0}; t < 64; ++t) wk[t] = w[t] + kRoundConstants[t];
+        compress(state, wk);
+    }
+}
+
+namespace {
+
+    struct CpuFeatures {
+        bool sse41{false};
+        bool avx2{false};
+        bool sha{false};
+    };
+
+    CpuFeatures detect_cpu_features() noexcept {
+        CpuFeatures ret;
+#if defined(ZEN_SHA256_X86)
+        uint32_t eax{0}, ebx{0}, ecx{0}, edx{0};
+#if defined(_MSC_VER)
+        int regs[4]{};
+        const auto cpuid{[&](int leaf, int subleaf) {
+            __cpuidex(regs, leaf, subleaf);
+            eax = static_cast<uint32_t>(regs[0]);
+            ebx = static_cast<uint32_t>(regs[1]);
+            ecx = static_cast<uint32_t>(regs[2]);
+            edx = static_cast<uint32_t>(regs[3]);
+        }};
+        cpuid(0, 0);
+        const uint32_t max_leaf{eax};
+        cpuid(1, 0);
+#else
+        const uint32_t max_leaf{__get_cpuid_max(0, nullptr)};
+        __cpuid_count(1, 0, eax, ebx, ecx, edx);
+#endif
+        const bool ssse3{(ecx & (1U << 9)) != 0};
+        ret.sse41 = ssse3 && (ecx & (1U << 19)) != 0;
+
+        // AVX registers must also be enabled by the OS (OSXSAVE and XCR0 bits for XMM and YMM state)
+        bool avx_enabled{false};
+        if ((ecx & (1U << 27)) != 0 && (ecx & (1U << 28)) != 0) {
+#if defined(_MSC_VER)
+            const uint64_t xcr0{_xgetbv(0)};
+#else
+            uint32_t xcr0_low{0}, xcr0_high{0};
+            __asm__("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+            const uint64_t xcr0{(static_cast<uint64_t>(xcr0_high) << 32) | xcr0_low};
+#endif
+            avx_enabled = (xcr0 & 0x6) == 0x6;
+        }
+
+        if (max_leaf >= 7) {
+#if defined(_MSC_VER)
+            cpuid(7, 0);
+#else
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+#endif
+            ret.avx2 = avx_enabled && ret.sse41 && (ebx & (1U << 5)) != 0;
+            ret.sha = ret.sse41 && (ebx & (1U << 29)) != 0;
+        }
+#endif
+        return ret;
+    }
+
+    const CpuFeatures& cpu_features() noexcept {
+        static const CpuFeatures features{detect_cpu_features()};
+        return features;
+    }
+
+}  // namespace
+
+bool is_supported(Backend backend) noexcept { return transform_function(backend) != nullptr; }
+
+TransformFunc transform_function(Backend backend) noexcept {
+    switch (backend) {
+        case Backend::kGeneric:
+            return transform_generic;
+#if defined(ZEN_SHA256_X86)
+        case Backend::kSse41:
+            return cpu_features().sse41 ? transform_sse41 : nullptr;
+        case Backend::kAvx2:
+            return cpu_features().avx2 ? transform_avx2 : nullptr;
+        case Backend::kShaNi:
+            return cpu_features().sha ? transform_shani : nullptr;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+Backend best_backend() noexcept {
+    static const Backend backend{[] {
+        for (const auto candidate : {Backend::kShaNi, Backend::kAvx2, Backend::kSse41}) {
+            if (is_supported(candidate)) return candidate;
+        }
+        return Backend::kGeneric;
+    }()};
+    return backend;
+}
+
+void transform(uint32_t* state, const uint8_t* blocks, size_t num_blocks) noexcept {
+    static const TransformFunc best_transform{transform_function(best_backend())};
+    best_transform(state, blocks, num_blocks);
+}
+
+std::string_view to_string(Backend backend) noexcept {
+    switch (backend) {
+        case Backend::kGeneric:
+            return "generic";
+        case Backend::kSse41:
+            return "sse4.1";
+        case Backend::kAvx2:
+            return "avx2";
+        case Backend::kShaNi:
+            return "sha-ni";
+    }
+    return "unknown";
+}
+
+}  // namespace zen::crypto::sha256
@@ -0,0 +1,84 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include <zen/core/common/base.hpp>
+#include <zen/core/types/hash.hpp>
+
+namespace zen::crypto::sha256 {
+
+//! \brief Implementations of the SHA-256 compression function
+enum class Backend {
+    kGeneric,  // Portable scalar code
+    kSse41,    // Message schedule vectorized with SSE4.1
+    kAvx2,     // Message schedules of two blocks vectorized at once with AVX2
+    kShaNi,    // Intel SHA extensions
+};
+
+//! \brief Strategies for hashing many independent messages
+enum class BatchMode {
+    kSequential,  // One message after the other with the best backend
+    kLanes4,      // Four messages interleaved in the lanes of 128 bit vectors
+    kLanes8,      // Eight messages interleaved in the lanes of 256 bit vectors (AVX2)
+};
+
+//! \brief Processes num_blocks consecutive 64 bytes blocks updating state
+using TransformFunc = void (*)(uint32_t* state, const uint8_t* blocks, size_t num_blocks);
+
+//! \brief The initial hash values (FIPS 180-4 5.3.3)
+inline constexpr std::array<uint32_t, 8> kInitialState{0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+                                                       0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
+//! \brief Returns the fastest backend supported by the running CPU (detected once)
+[[nodiscard]] Backend best_backend() noexcept;
+
+//! \brief Whether a backend is built and supported by the running CPU
+[[nodiscard]] bool is_supported(Backend backend) noexcept;
+
+//! \brief Returns the implementation of a backend or nullptr when not supported
+[[nodiscard]] TransformFunc transform_function(Backend backend) noexcept;
+
+//! \brief Processes num_blocks consecutive 64 bytes blocks with the best backend
+void transform(uint32_t* state, const uint8_t* blocks, size_t num_blocks) noexcept;
+
+[[nodiscard]] std::string_view to_string(Backend backend) noexcept;
+
+//! \brief Returns the fastest batch mode on the running CPU
+//! \remarks With SHA extensions one message at a time beats the interleaved modes
+[[nodiscard]] BatchMode best_batch_mode() noexcept;
+
+//! \brief Whether a batch mode is built and supported by the running CPU
+[[nodiscard]] bool is_supported(BatchMode mode) noexcept;
+
+//! \brief Computes the SHA-256 digests of many independent messages of any length
+//! \param [in] inputs : the messages
+//! \param [out] outputs : the digests (same size as inputs)
+//! \remarks An output may overlap the input at the same position : each message is consumed before its digest is
+//! written. Lanes are refilled as soon as their message is done hence mixed lengths keep all lanes busy
+void hash_many(std::span<const ByteView> inputs, std::span<h256> outputs, BatchMode mode) noexcept;
+
+//! \brief Same as above with the best batch mode
+void hash_many(std::span<const ByteView> inputs, std::span<h256> outputs) noexcept;
+
+//! \brief Computes the double SHA-256 digests of count consecutive 64 bytes messages (e.g. pairs of merkle nodes)
+//! \param [in] in : count * 64 bytes
+//! \param [out] out : count * 32 bytes. May be the same as in : each digest only overwrites messages already hashed
+//! \details Both padding blocks are constants and no byte is buffered
+void double_hash_64(const uint8_t* in, uint8_t* out, size_t count, BatchMode mode) noexcept;
+
+//! \brief Same as above with the best batch mode
+void double_hash_64(const uint8_t* in, uint8_t* out, size_t count) noexcept;
+
+[[nodiscard]] std::string_view to_string(BatchMode mode) noexcept;
+
+}  // namespace zen::crypto::sha256
@@ -0,0 +1,208 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <zen/core/crypto/sha_2_256_impl.hpp>
+
+#if defined(ZEN_SHA256_X86)
+
+#include <immintrin.h>
+
+// Intrinsics are enabled per function (see ZEN_SHA256_TARGET) : the rest of the build keeps the baseline ISA and
+// these functions are only called when the running CPU supports them (see transform_function)
+
+namespace zen::crypto::sha256 {
+
+namespace {
+
+    // Shuffle mask turning big endian words into native ones
+    ZEN_SHA256_TARGET("sse4.1") inline __m128i byteswap_mask() noexcept {
+        return _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    }
+
+    ZEN_SHA256_TARGET("sse4.1") inline __m128i load(const uint32_t* src) noexcept {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    }
+
+    ZEN_SHA256_TARGET("sse4.1") inline __m128i rotr(__m128i x, int n) noexcept {
+        return _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n));
+    }
+
+    ZEN_SHA256_TARGET("sse4.1") inline __m128i sigma0(__m128i x) noexcept {
+        return _mm_xor_si128(_mm_xor_si128(rotr(x, 7), rotr(x, 18)), _mm_srli_epi32(x, 3));
+    }
+
+    ZEN_SHA256_TARGET("sse4.1") inline __m128i sigma1(__m128i x) noexcept {
+        return _mm_xor_si128(_mm_xor_si128(rotr(x, 17), rotr(x, 19)), _mm_srli_epi32(x, 10));
+    }
+
+    //! \brief Computes the next 4 words of the message schedule
+    //! \details x0..x3 hold the previous 16 words. W[t-2] and W[t-1] feed W[t] and W[t+1] which in turn feed W[t+2]
+    //! and W[t+3] hence sigma1 is applied in two halves
+    ZEN_SHA256_TARGET("sse4.1") inline __m128i next_words(__m128i x0, __m128i x1, __m128i x2, __m128i x3) noexcept {
+        __m128i w{_mm_add_epi32(x0, sigma0(_mm_alignr_epi8(x1, x0, 4)))};
+        w = _mm_add_epi32(w, _mm_alignr_epi8(x3, x2, 4));
+        w = _mm_add_epi32(w, _mm_move_epi64(sigma1(_mm_shuffle_epi32(x3, 0xfe))));
+        return _mm_add_epi32(w, _mm_slli_si128(sigma1(w), 8));
+    }
+
+    ZEN_SHA256_TARGET("avx2") inline __m256i rotr(__m256i x, int n) noexcept {
+        return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+    }
+
+    ZEN_SHA256_TARGET("avx2") inline __m256i sigma0(__m256i x) noexcept {
+        return _mm256_xor_si256(_mm256_xor_si256(rotr(x, 7), rotr(x, 18)), _mm256_srli_epi32(x, 3));
+    }
+
+    ZEN_SHA256_TARGET("avx2") inline __m256i sigma1(__m256i x) noexcept {
+        return _mm256_xor_si256(_mm256_xor_si256(rotr(x, 17), rotr(x, 19)), _mm256_srli_epi32(x, 10));
+    }
+
+    //! \brief Same as the 128 bit version on two blocks at once : one per lane
+    ZEN_SHA256_TARGET("avx2") inline __m256i next_words(__m256i x0, __m256i x1, __m256i x2, __m256i x3) noexcept {
+        __m256i w{_mm256_add_epi32(x0, sigma0(_mm256_alignr_epi8(x1, x0, 4)))};
+        w = _mm256_add_epi32(w, _mm256_alignr_epi8(x3, x2, 4));
+        const __m256i low_half{sigma1(_mm256_shuffle_epi32(x3, 0xfe))};
+        w = _mm256_add_epi32(w, _mm256_blend_epi32(_mm256_setzero_si256(), low_half, 0x33));
+        return _mm256_add_epi32(w, _mm256_slli_si256(sigma1(w), 8));
+    }
+
+    ZEN_SHA256_TARGET("sse4.1") void schedule_sse41(const uint8_t* block, Schedule& wk) noexcept {
+        const __m128i mask{byteswap_mask()};
+        __m128i x[4];  // Last 16 words (std::array drops the vector type attributes)
+        for (size_t i{0}; i < 4; ++i) {
+            x[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16)), mask);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&wk[i * 4]),
+                             _mm_add_epi32(x[i], load(&kRoundConstants[i * 4])));
+        }
+        for (size_t t{16}; t < 64; t += 16) {
+            for (size_t i{0}; i < 4; ++i) {
+                x[i] = next_words(x[i], x[(i + 1) & 3], x[(i + 2) & 3], x[(i + 3) & 3]);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&wk[t + i * 4]),
+                                 _mm_add_epi32(x[i], load(&kRoundConstants[t + i * 4])));
+            }
+        }
+    }
+
+    //! \brief Adds the round constants to the words at t of both schedules and stores them
+    ZEN_SHA256_TARGET("avx2") inline void store(size_t t, __m256i words, Schedule& wk0, Schedule& wk1) noexcept {
+        const __m256i sum{_mm256_add_epi32(words, _mm256_broadcastsi128_si256(load(&kRoundConstants[t])))};
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&wk0[t]), _mm256_castsi256_si128(sum));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&wk1[t]), _mm256_extracti128_si256(sum, 1));
+    }
+
+    ZEN_SHA256_TARGET("avx2")
+    void schedule_avx2(const uint8_t* block0, const uint8_t* block1, Schedule& wk0, Schedule& wk1) noexcept {
+        const __m256i mask{_mm256_broadcastsi128_si256(byteswap_mask())};
+        __m256i x[4];
+        for (size_t i{0}; i < 4; ++i) {
+            const __m256i words{_mm256_inserti128_si256(
+                _mm256_castsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block0 + i * 16))),
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(block1 + i * 16)), 1)};
+            x[i] = _mm256_shuffle_epi8(words, mask);
+            store(i * 4, x[i], wk0, wk1);
+        }
+        for (size_t t{16}; t < 64; t += 16) {
+            for (size_t i{0}; i < 4; ++i) {
+                x[i] = next_words(x[i], x[(i + 1) & 3], x[(i + 2) & 3], x[(i + 3) & 3]);
+                store(t + i * 4, x[i], wk0, wk1);
+            }
+        }
+    }
+
+    //! \brief Four rounds with SHA extensions, the first two on the low half of msg_k, the last two on the high one
+    ZEN_SHA256_TARGET("sha,sse4.1")
+    inline void quad_round(__m128i& abef, __m128i& cdgh, __m128i msg_k) noexcept {
+        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg_k);
+        abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg_k, 0x0e));
+    }
+
+    //! \brief Four rounds also completing the schedule of next (from current and previous) and starting the one of
+    //! previous (which then becomes the schedule of the rounds 12 ahead)
+    ZEN_SHA256_TARGET("sha,sse4.1")
+    inline void quad_round(__m128i& abef, __m128i& cdgh, const __m128i& current, __m128i& next, __m128i& previous,
+                           const uint32_t* k, bool complete_next, bool start_previous) noexcept {
+        const __m128i msg_k{_mm_add_epi32(current, load(k))};
+        cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg_k);
+        if (complete_next) {
+            next = _mm_sha256msg2_epu32(_mm_add_epi32(next, _mm_alignr_epi8(current, previous, 4)), current);
+        }
+        abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(msg_k, 0x0e));
+        if (start_previous) previous = _mm_sha256msg1_epu32(previous, current);
+    }
+
+}  // namespace
+
+ZEN_SHA256_TARGET("sse4.1") void transform_sse41(uint32_t* state, const uint8_t* blocks, size_t num_blocks) {
+    Schedule wk;
+    for (; num_blocks != 0; --num_blocks, blocks += 64) {
+        schedule_sse41(blocks, wk);
+        compress(state, wk);
+    }
+}
+
+ZEN_SHA256_TARGET("avx2") void transform_avx2(uint32_t* state, const uint8_t* blocks, size_t num_blocks) {
+    // Blocks are chained hence only the schedules can be computed in parallel
+    Schedule wk0;
+    Schedule wk1;
+    for (; num_blocks >= 2; num_blocks -= 2, blocks += 128) {
+        schedule_avx2(blocks, blocks + 64, wk0, wk1);
+        compress(state, wk0);
+        compress(state, wk1);
+    }
+    if (num_blocks != 0) transform_sse41(state, blocks, num_blocks);
+}
+
+ZEN_SHA256_TARGET("sha,sse4.1") void transform_shani(uint32_t* state, const uint8_t* blocks, size_t num_blocks) {
+    const __m128i mask{byteswap_mask()};
+
+    // The SHA instructions work on state words arranged as ABEF and CDGH
+    const __m128i dcba{_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]))};
+    const __m128i hgfe{_mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]))};
+    const __m128i cdab{_mm_shuffle_epi32(dcba, 0xb1)};
+    const __m128i efgh{_mm_shuffle_epi32(hgfe, 0x1b)};
+    __m128i abef{_mm_alignr_epi8(cdab, efgh, 8)};
+    __m128i cdgh{_mm_blend_epi16(efgh, cdab, 0xf0)};
+
+    const uint32_t* k{kRoundConstants.data()};
+    for (; num_blocks != 0; --num_blocks, blocks += 64) {
+        const __m128i abef_save{abef};
+        const __m128i cdgh_save{cdgh};
+
+        __m128i m0{_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks)), mask)};
+        __m128i m1{_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 16)), mask)};
+        __m128i m2{_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 32)), mask)};
+        __m128i m3{_mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(blocks + 48)), mask)};
+
+        quad_round(abef, cdgh, _mm_add_epi32(m0, load(k)));  // Rounds 0-3
+        quad_round(abef, cdgh, m1, m2, m0, k + 4, false, true);
+        quad_round(abef, cdgh, m2, m3, m1, k + 8, false, true);
+        quad_round(abef, cdgh, m3, m0, m2, k + 12, true, true);
+        quad_round(abef, cdgh, m0, m1, m3, k + 16, true, true);
+        quad_round(abef, cdgh, m1, m2, m0, k + 20, true, true);
+        quad_round(abef, cdgh, m2, m3, m1, k + 24, true, true);
+        quad_round(abef, cdgh, m3, m0, m2, k + 28, true, true);
+        quad_round(abef, cdgh, m0, m1, m3, k + 32, true, true);
+        quad_round(abef, cdgh, m1, m2, m0, k + 36, true, true);
+        quad_round(abef, cdgh, m2, m3, m1, k + 40, true, true);
+        quad_round(abef, cdgh, m3, m0, m2, k + 44, true, true);
+        quad_round(abef, cdgh, m0, m1, m3, k + 48, true, true);
+        quad_round(abef, cdgh, m1, m2, m0, k + 52, true, false);
+        quad_round(abef, cdgh, m2, m3, m1, k + 56, true, false);
+        quad_round(abef, cdgh, _mm_add_epi32(m3, load(k + 60)));  // Rounds 60-63
+
+        abef = _mm_add_epi32(abef, abef_save);
+        cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+    const __m128i feba{_mm_shuffle_epi32(abef, 0x1b)};
+    const __m128i dchg{_mm_shuffle_epi32(cdgh, 0xb1)};
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), _mm_blend_epi16(feba, dchg, 0xf0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+}  // namespace zen::crypto::sha256
+
+#endif  // ZEN_SHA256_X86
@@ -12,19 +12,21 @@ namespace zen::crypto {
 //! \brief A wrapper around OpenSSL's SHA512 crypto functions
 class Sha512 : public Hasher {
   public:
-    Sha512();
+    explicit Sha512(HasherPolicy policy = HasherPolicy::kPublic);
     ~Sha512() override;
 
     explicit Sha512(ByteView initial_data);
     explicit Sha512(std::string_view initial_data);
 
     void init() noexcept override;
-    [[nodiscard]] Bytes finalize() noexcept override;
+    using Hasher::finalize;
+    void finalize(std::span<uint8_t> out) noexcept override;
     [[nodiscard]] Bytes finalize_nopadding(bool compression) const noexcept;
 
   private:
-    std::unique_ptr<SHA512_CTX> ctx_{nullptr};
-    static ZEN_THREAD_LOCAL ObjectPool<SHA512_CTX> ctx_pool_;
+    SHA512_CTX ctx_{};
+
+    void store_state(std::span<uint8_t> out) const noexcept;
 
     void init_context() override;
     void transform(const unsigned char* data) override;
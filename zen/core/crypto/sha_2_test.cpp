@@ -10,6 +10,7 @@
 
 #include <zen/core/crypto/hasher_test.hpp>
 #include <zen/core/crypto/sha_2_256.hpp>
+#include <zen/core/crypto/sha_2_256_transform.hpp>
 #include <zen/core/crypto/sha_2_512.hpp>
 
 namespace zen::crypto {
@@ -79,4 +80,93 @@ TEST_CASE("Sha2 test vectors", "[crypto]") {
         run_hasher_tests(hasher, inputs, digests);
     }
 }
+
+TEST_CASE("Sha256 backends", "[crypto]") {
+    using namespace sha256;
+    REQUIRE(is_supported(Backend::kGeneric));
+    REQUIRE(is_supported(best_backend()));
+
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint32_t> uni(0, 255);
+    Bytes blocks(64 * 9, 0);
+    for (auto& b : blocks) b = static_cast<uint8_t>(uni(rng));
+
+    for (const auto backend : {Backend::kGeneric, Backend::kSse41, Backend::kAvx2, Backend::kShaNi}) {
+        const auto transform_func{transform_function(backend)};
+        if (!transform_func) continue;
+        INFO("Backend " << to_string(backend));
+
+        // Every backend must match the generic one for any number of blocks (also odd for paired backends)
+        for (size_t num_blocks{0}; num_blocks <= 9; ++num_blocks) {
+            auto expected{kInitialState};
+            transform_function(Backend::kGeneric)(expected.data(), blocks.data(), num_blocks);
+            auto actual{kInitialState};
+            transform_func(actual.data(), blocks.data(), num_blocks);
+            CHECK(actual == expected);
+        }
+
+        // Known answer : "abc" padded to one block
+        Bytes abc_block(64, 0);
+        abc_block[0] = 'a';
+        abc_block[1] = 'b';
+        abc_block[2] = 'c';
+        abc_block[3] = 0x80;
+        abc_block[63] = 24;  // Bit length
+        auto state{kInitialState};
+        transform_func(state.data(), abc_block.data(), 1);
+        CHECK(state[0] == 0xba7816bf);
+        CHECK(state[7] == 0xf20015ad);
+
+        // Many blocks in one call or one block per call
+        auto one_call{kInitialState};
+        transform_func(one_call.data(), blocks.data(), 9);
+        auto many_calls{kInitialState};
+        for (size_t i{0}; i < 9; ++i) transform_func(many_calls.data(), &blocks[i * 64], 1);
+        CHECK(one_call == many_calls);
+    }
+}
+
+TEST_CASE("Sha256 hash many", "[crypto]") {
+    using namespace sha256;
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<uint32_t> uni(0, 255);
+
+    // Mixed lengths, including those around block and padding boundaries
+    std::vector<Bytes> messages;
+    for (const size_t size : {0U, 1U, 55U, 56U, 63U, 64U, 65U, 80U, 119U, 120U, 128U, 200U, 1'000U}) {
+        Bytes message(size, 0);
+        for (auto& b : message) b = static_cast<uint8_t>(uni(rng));
+        messages.push_back(std::move(message));
+    }
+    for (size_t i{0}; i < 40; ++i) messages.emplace_back(64, static_cast<uint8_t>(i));  // Merkle nodes
+    for (size_t i{0}; i < 40; ++i) messages.emplace_back(80, static_cast<uint8_t>(i));  // Headers
+
+    std::vector<ByteView> inputs(messages.begin(), messages.end());
+    std::vector<h256> expected(inputs.size());
+    for (size_t i{0}; i < inputs.size(); ++i) {
+        Sha256 hasher(inputs[i]);
+        expected[i] = h256(hasher.finalize());
+    }
+
+    for (const auto mode : {BatchMode::kSequential, BatchMode::kLanes4, BatchMode::kLanes8}) {
+        if (!is_supported(mode)) continue;
+        INFO("Batch mode " << to_string(mode));
+        std::vector<h256> digests(inputs.size());
+        hash_many(inputs, digests, mode);
+        CHECK(digests == expected);
+
+        // Fewer messages than lanes
+        std::vector<h256> few(3);
+        hash_many(std::span(inputs).first(3), few, mode);
+        CHECK(std::equal(few.begin(), few.end(), expected.begin()));
+
+        // Nothing to do
+        hash_many({}, {}, mode);
+    }
+
+    std::vector<h256> digests(inputs.size());
+    Sha256::hash_many(inputs, digests);
+    CHECK(digests == expected);
+}
+
 }  // namespace zen::crypto
@@ -8,8 +8,12 @@
 
 #include <array>
 #include <bit>
+#include <cstring>
 #include <type_traits>
 
+#include <tl/expected.hpp>
+
+#include <zen/core/common/assert.hpp>
 #include <zen/core/common/base.hpp>
 #include <zen/core/serialization/base.hpp>
 
@@ -33,7 +37,7 @@ inline uint32_t ser_sizeof(bool) {
 //! \brief Returns the serialzed size of a compacted integral
 //! \remarks Mostly used in P2P messages to prepend a list of elements with the count of elements.
 //! Not to be confused with varint which is used in storage serialization
-uint32_t ser_compact_sizeof(uint64_t value) {
+inline uint32_t ser_compact_sizeof(uint64_t value) {
     if (value < 253)
         return 1;  // One byte only
     else if (value <= 0xffff)
@@ -9,6 +9,7 @@
 #include <zen/core/crypto/sha_2_256.hpp>
 #include <zen/core/encoding/hex.hpp>
 #include <zen/core/serialization/serialize.hpp>
+#include <zen/core/serialization/span_stream.hpp>
 #include <zen/core/serialization/stream.hpp>
 
 namespace zen::ser {
@@ -335,4 +336,29 @@ TEST_CASE("Serialization of base types", "[serialization]") {
         CHECK(value.error() == DeserializationError::kCompactSizeTooBig);
     }
 }
+
+TEST_CASE("Span stream", "[serialization]") {
+    std::array<uint8_t, 16> destination{};
+    SpanStream stream(destination);
+    CHECK(stream.avail() == destination.size());
+
+    write_data(stream, uint32_t{0x01020304});
+    write_compact(stream, 0xfffa);
+    write_data(stream, true);
+    stream.write(Bytes{0xaa, 0xbb, 0xcc});
+    CHECK(stream.size() == 11);
+    CHECK(stream.avail() == 5);
+    CHECK_FALSE(stream.full());
+
+    // Same encoding as DataStream
+    DataStream data_stream(Scope::kStorage, 0);
+    write_data(data_stream, uint32_t{0x01020304});
+    write_compact(data_stream, 0xfffa);
+    write_data(data_stream, true);
+    data_stream.write(Bytes{0xaa, 0xbb, 0xcc});
+    CHECK(data_stream.to_string() == hex::encode({destination.data(), stream.size()}));
+
+    stream.write(Bytes(5, 0xff));
+    CHECK(stream.full());
+}
 }  // namespace zen::ser
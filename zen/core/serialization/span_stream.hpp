@@ -0,0 +1,58 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <cstring>
+#include <span>
+
+#include <zen/core/common/assert.hpp>
+#include <zen/core/common/base.hpp>
+
+namespace zen::ser {
+
+//! \brief A write-only stream over a fixed size, externally owned, memory area
+//! \details Implements the subset of DataStream's interface used by serialization functions (write_data, write_compact
+//! etc.) so objects can be serialized straight into their final destination (e.g. a value space reserved in a db
+//! page) with no intermediate buffer
+//! \remarks The size of the area is expected to match the serialized size : overflows are programming errors
+class SpanStream {
+  public:
+    using size_type = std::size_t;
+    using value_type = uint8_t;
+
+    explicit SpanStream(std::span<uint8_t> destination) noexcept : destination_{destination} {}
+
+    //! \brief Appends provided data
+    void write(ByteView data) { write(data.data(), data.size()); }
+
+    //! \brief Appends provided data
+    void write(const uint8_t* ptr, size_type count) {
+        ZEN_ASSERT(count <= avail());
+        if (count) std::memcpy(&destination_[position_], ptr, count);
+        position_ += count;
+    }
+
+    //! \brief Appends a single byte
+    void push_back(value_type item) {
+        ZEN_ASSERT(avail() != 0);
+        destination_[position_++] = item;
+    }
+
+    //! \brief Returns the number of bytes written so far
+    [[nodiscard]] size_type size() const noexcept { return position_; }
+
+    //! \brief Returns the number of bytes which can still be written
+    [[nodiscard]] size_type avail() const noexcept { return destination_.size() - position_; }
+
+    //! \brief Whether the whole destination area has been written
+    [[nodiscard]] bool full() const noexcept { return position_ == destination_.size(); }
+
+  private:
+    std::span<uint8_t> destination_;
+    size_type position_{0};
+};
+
+}  // namespace zen::ser
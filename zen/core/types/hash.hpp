@@ -76,6 +76,7 @@ class Hash {
     void reset() { memset(&bytes_, 0, kSize); }
 
     [[nodiscard]] const uint8_t* data() const noexcept { return bytes_.data(); }
+    [[nodiscard]] uint8_t* data() noexcept { return bytes_.data(); }
 
     iterator_type begin() noexcept { return bytes_.begin(); }
 
@@ -105,5 +105,8 @@ class DataDirectory final : public Directory {
         std::ignore = operator[]("etl-tmp");
         std::ignore = operator[]("nodes");
     }
+
+    //! \brief Returns the directory where temporary files from etl collector are stored
+    [[nodiscard]] Directory etl() { return operator[]("etl-tmp"); }
 };
 }  // namespace zen
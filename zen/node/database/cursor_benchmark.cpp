@@ -0,0 +1,255 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <zen/core/common/endian.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/mdbx.hpp>
+
+/*
+ * Database layer micro-benchmarks
+ * All cases run on an on-disk environment in a temporary directory and take two arguments : the page size of the
+ * environment and the size of values. Keys are 8 bytes big endian integers.
+ */
+
+namespace zen::db {
+
+static const MapConfig kSuiteMapConfig{"BenchSuite"};
+
+static constexpr uint64_t kRecords{100'000};  // Records of populated maps
+static constexpr uint64_t kBatch{10'000};     // Records written per iteration by insertion cases
+
+static void page_and_value_sizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"page_size", "value_size"});
+    for (const int64_t page_size : {4'096, 16'384, 65'536}) {
+        for (const int64_t value_size : {32, 256, 1'024}) {
+            bench->Args({page_size, value_size});
+        }
+    }
+}
+
+// A temporary environment configured on behalf of benchmark arguments
+class BenchEnv {
+  public:
+    explicit BenchEnv(const benchmark::State& state, DurabilityMode durability = DurabilityMode::kDurable)
+        : env_{open_env(make_config(tmp_dir_, state, durability))}, value_(static_cast<size_t>(state.range(1)), 0xaa) {}
+
+    [[nodiscard]] ::mdbx::env_managed& env() noexcept { return env_; }
+    [[nodiscard]] ByteView value() const noexcept { return value_; }
+
+    //! \brief Commits kRecords records with sequential keys
+    void populate() {
+        RWTxn txn{env_};
+        Cursor cursor(txn, kSuiteMapConfig);
+        for (uint64_t i{0}; i < kRecords; ++i) {
+            std::ignore = cursor_append(cursor, make_key(i), value_);
+        }
+        txn.commit(/*renew=*/false);
+    }
+
+    static Bytes make_key(uint64_t value) {
+        Bytes ret(sizeof(uint64_t), 0);
+        endian::store_big_u64(ret.data(), value);
+        return ret;
+    }
+
+  private:
+    static EnvConfig make_config(const TempDirectory& tmp_dir, const benchmark::State& state,
+                                 DurabilityMode durability) {
+        EnvConfig ret{tmp_dir.path().string(), /*create*/ true};
+        ret.page_size = static_cast<size_t>(state.range(0));
+        ret.durability = durability;
+        return ret;
+    }
+
+    const TempDirectory tmp_dir_;
+    ::mdbx::env_managed env_;
+    const Bytes value_;
+};
+
+static std::vector<Bytes> make_keys(size_t count, bool random) {
+    std::vector<Bytes> ret;
+    ret.reserve(count);
+    std::mt19937_64 rng{0};
+    for (uint64_t i{0}; i < count; ++i) ret.push_back(BenchEnv::make_key(random ? rng() : i));
+    return ret;
+}
+
+// Writes a batch of records per iteration in a transaction which is then aborted
+template <typename WriteFunc>
+static void bench_insert(benchmark::State& state, const std::vector<Bytes>& keys, WriteFunc&& write_func) {
+    BenchEnv bench_env{state};
+    {
+        // Have the map created upfront
+        RWTxn txn{bench_env.env()};
+        (void)open_map(*txn, kSuiteMapConfig);
+        txn.commit(/*renew=*/false);
+    }
+    for ([[maybe_unused]] auto _ : state) {
+        auto txn{bench_env.env().start_write()};
+        {
+            Cursor cursor(txn, kSuiteMapConfig);
+            for (const auto& key : keys) write_func(cursor, key, bench_env.value());
+        }
+        state.PauseTiming();
+        txn.abort();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(keys.size()));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(keys.size() * bench_env.value().size()));
+}
+
+void bench_insert_sequential(benchmark::State& state) {
+    bench_insert(state, make_keys(kBatch, /*random=*/false),
+                 [](Cursor& cursor, ByteView key, ByteView value) { cursor.upsert(to_slice(key), to_slice(value)); });
+}
+
+void bench_insert_random(benchmark::State& state) {
+    bench_insert(state, make_keys(kBatch, /*random=*/true),
+                 [](Cursor& cursor, ByteView key, ByteView value) { cursor.upsert(to_slice(key), to_slice(value)); });
+}
+
+void bench_insert_append(benchmark::State& state) {
+    bench_insert(state, make_keys(kBatch, /*random=*/false),
+                 [](Cursor& cursor, ByteView key, ByteView value) { std::ignore = cursor_append(cursor, key, value); });
+}
+
+// Walks a populated map per iteration
+static void bench_scan(benchmark::State& state, CursorMoveDirection direction) {
+    BenchEnv bench_env{state};
+    bench_env.populate();
+    auto txn{bench_env.env().start_read()};
+    Cursor cursor(txn, kSuiteMapConfig);
+    size_t bytes{0};
+    for ([[maybe_unused]] auto _ : state) {
+        if (direction == CursorMoveDirection::Forward) {
+            std::ignore = cursor.to_first();
+        } else {
+            std::ignore = cursor.to_last();
+        }
+        cursor_for_each(
+            cursor, [&bytes](ByteView key, ByteView value) { bytes += key.size() + value.size(); }, direction);
+    }
+    benchmark::DoNotOptimize(bytes);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(kRecords));
+}
+
+void bench_scan_forward(benchmark::State& state) { bench_scan(state, CursorMoveDirection::Forward); }
+
+void bench_scan_reverse(benchmark::State& state) { bench_scan(state, CursorMoveDirection::Reverse); }
+
+// Walks the records sharing a random 7 bytes prefix (i.e. 256 records) per iteration
+void bench_scan_prefix(benchmark::State& state) {
+    BenchEnv bench_env{state};
+    bench_env.populate();
+    auto txn{bench_env.env().start_read()};
+    Cursor cursor(txn, kSuiteMapConfig);
+    std::mt19937_64 rng{0};
+    int64_t items_processed{0};
+    for ([[maybe_unused]] auto _ : state) {
+        const auto key{BenchEnv::make_key(rng() % kRecords)};
+        items_processed += static_cast<int64_t>(
+            cursor_for_prefix(cursor, ByteView{key}.substr(0, sizeof(uint64_t) - 1), [](ByteView, ByteView) {}));
+    }
+    state.SetItemsProcessed(items_processed);
+}
+
+void bench_point_lookup(benchmark::State& state) {
+    BenchEnv bench_env{state};
+    bench_env.populate();
+    const auto keys{make_keys(kBatch, /*random=*/false)};
+    std::vector<const Bytes*> shuffled;
+    for (const auto& key : keys) shuffled.push_back(&key);
+    std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64{0});
+
+    auto txn{bench_env.env().start_read()};
+    Cursor cursor(txn, kSuiteMapConfig);
+    for ([[maybe_unused]] auto _ : state) {
+        for (const auto* key : shuffled) benchmark::DoNotOptimize(cursor.find(to_slice(*key)));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(shuffled.size()));
+}
+
+// Erases the upper half of a populated map per iteration in a transaction which is then aborted
+void bench_cursor_erase(benchmark::State& state) {
+    BenchEnv bench_env{state};
+    bench_env.populate();
+    const auto set_key{BenchEnv::make_key(kRecords / 2)};
+    int64_t items_processed{0};
+    for ([[maybe_unused]] auto _ : state) {
+        auto txn{bench_env.env().start_write()};
+        {
+            Cursor cursor(txn, kSuiteMapConfig);
+            items_processed += static_cast<int64_t>(cursor_erase(cursor, set_key));
+        }
+        state.PauseTiming();
+        txn.abort();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(items_processed);
+}
+
+// Constructs a cursor per iteration either recycling handles from the pool (warm) or closing them (cold) so that
+// each construction allocates a new handle
+static void bench_cursor_pool(benchmark::State& state, bool warm) {
+    BenchEnv bench_env{state};
+    bench_env.populate();
+    auto txn{bench_env.env().start_read()};
+    for ([[maybe_unused]] auto _ : state) {
+        Cursor cursor(txn, kSuiteMapConfig);
+        benchmark::DoNotOptimize(cursor.map().dbi);
+        if (!warm) cursor.close();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void bench_cursor_warm_pool(benchmark::State& state) { bench_cursor_pool(state, /*warm=*/true); }
+
+void bench_cursor_cold_pool(benchmark::State& state) { bench_cursor_pool(state, /*warm=*/false); }
+
+// Commits a transaction of 16 records per iteration with the durability mode given as third argument
+void bench_commit_latency(benchmark::State& state) {
+    BenchEnv bench_env{state, static_cast<DurabilityMode>(state.range(2))};
+    uint64_t counter{0};
+    for ([[maybe_unused]] auto _ : state) {
+        RWTxn txn{bench_env.env()};
+        Cursor cursor(txn, kSuiteMapConfig);
+        for (int i{0}; i < 16; ++i) {
+            std::ignore = cursor_append(cursor, BenchEnv::make_key(counter++), bench_env.value());
+        }
+        txn.commit(/*renew=*/false);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(bench_insert_sequential)->Apply(page_and_value_sizes);
+BENCHMARK(bench_insert_random)->Apply(page_and_value_sizes);
+BENCHMARK(bench_insert_append)->Apply(page_and_value_sizes);
+BENCHMARK(bench_scan_forward)->Apply(page_and_value_sizes);
+BENCHMARK(bench_scan_reverse)->Apply(page_and_value_sizes);
+BENCHMARK(bench_scan_prefix)->Apply(page_and_value_sizes);
+BENCHMARK(bench_point_lookup)->Apply(page_and_value_sizes);
+BENCHMARK(bench_cursor_erase)->Apply(page_and_value_sizes);
+BENCHMARK(bench_cursor_warm_pool)->Args({4'096, 32});
+BENCHMARK(bench_cursor_cold_pool)->Args({4'096, 32});
+BENCHMARK(bench_commit_latency)->Apply([](benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"page_size", "value_size", "durability"});
+    for (const int64_t page_size : {4'096, 16'384, 65'536}) {
+        for (const int64_t value_size : {32, 1'024}) {
+            for (const auto durability : {DurabilityMode::kDurable, DurabilityMode::kLazy}) {
+                bench->Args({page_size, value_size, static_cast<int64_t>(durability)});
+            }
+        }
+    }
+});
+
+}  // namespace zen::db
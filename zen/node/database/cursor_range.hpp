@@ -0,0 +1,121 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+#include <zen/core/common/base.hpp>
+
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+//! \brief A lazy, single pass, view over the records of a map reachable by a cursor within a [begin, end) key range
+//! \details Records are yielded as pairs of views into db pages (no copies) which are valid until the transaction ends
+//! or the map is modified. The cursor is positioned when begin() is invoked and moved on each increment, hence
+//! composing with std::views (take_while, transform, filter ...) compiles down to the plain cursor loop and stopping
+//! early (e.g. break or std::views::take) costs nothing.
+//! \remarks Bounds are compared lexicographically which matches the default key collation of maps (i.e. not for
+//! MDBX_REVERSEKEY / MDBX_INTEGERKEY maps). On multi-value maps all values of each key are yielded. The range holds
+//! the position of the iteration hence it must outlive its iterators and must not be moved while iterating
+class CursorRange : public std::ranges::view_interface<CursorRange> {
+  public:
+    using value_type = std::pair<ByteView, ByteView>;
+
+    class iterator {
+      public:
+        using value_type = CursorRange::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(CursorRange* range) noexcept : range_{range} {}
+
+        const value_type& operator*() const noexcept { return range_->current_; }
+        const value_type* operator->() const noexcept { return &range_->current_; }
+
+        iterator& operator++() {
+            range_->next();
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        friend bool operator==(const iterator& it, std::default_sentinel_t) noexcept { return it.at_end(); }
+
+      private:
+        [[nodiscard]] bool at_end() const noexcept { return !range_ || range_->done_; }
+
+        CursorRange* range_{nullptr};
+    };
+
+    CursorRange() = default;
+
+    //! \param [in] cursor : A reference to a cursor opened on a map
+    //! \param [in] begin : The lower bound (inclusive) of keys. Empty means from the first record
+    //! \param [in] end : The upper bound (exclusive) of keys. Empty means up to the last record
+    //! \param [in] direction : Whether records are yielded in ascending (default) or descending key order
+    CursorRange(::mdbx::cursor& cursor, ByteView begin, ByteView end,
+                CursorMoveDirection direction = CursorMoveDirection::Forward)
+        : cursor_{&cursor}, begin_{begin}, end_{end}, direction_{direction} {}
+
+    //! \brief Positions the cursor on the first record of the range (in the iteration direction)
+    [[nodiscard]] iterator begin() {
+        if (direction_ == CursorMoveDirection::Forward) {
+            assign(begin_.empty() ? cursor_->to_first(/*throw_notfound=*/false)
+                                  : cursor_->lower_bound(to_slice(begin_), /*throw_notfound=*/false));
+        } else if (end_.empty()) {
+            assign(cursor_->to_last(/*throw_notfound=*/false));
+        } else if (cursor_->lower_bound(to_slice(end_), /*throw_notfound=*/false)) {
+            assign(cursor_->to_previous(/*throw_notfound=*/false));  // last record before end
+        } else {
+            assign(cursor_->to_last(/*throw_notfound=*/false));  // all keys are lower than end
+        }
+        return iterator{this};
+    }
+
+    [[nodiscard]] static std::default_sentinel_t end() noexcept { return std::default_sentinel; }
+
+  private:
+    void next() {
+        assign(direction_ == CursorMoveDirection::Forward ? cursor_->to_next(/*throw_notfound=*/false)
+                                                          : cursor_->to_previous(/*throw_notfound=*/false));
+    }
+
+    void assign(const ::mdbx::cursor::move_result& data) {
+        if (!data) {
+            done_ = true;
+            return;
+        }
+        current_ = {from_slice(data.key), from_slice(data.value)};
+        done_ = direction_ == CursorMoveDirection::Forward ? (!end_.empty() && current_.first >= end_)
+                                                           : current_.first < begin_;
+    }
+
+    ::mdbx::cursor* cursor_{nullptr};
+    Bytes begin_{};
+    Bytes end_{};
+    CursorMoveDirection direction_{CursorMoveDirection::Forward};
+    value_type current_{};
+    bool done_{true};
+};
+
+//! \brief Returns a view over the records of a map with keys in [begin, end) (see CursorRange)
+[[nodiscard]] inline CursorRange cursor_range(::mdbx::cursor& cursor, ByteView begin = {}, ByteView end = {},
+                                              CursorMoveDirection direction = CursorMoveDirection::Forward) {
+    return {cursor, begin, end, direction};
+}
+
+//! \brief Returns a view over the records of a map with keys starting with prefix (see CursorRange)
+//! \remarks In reverse direction iteration starts from the last key with prefix
+[[nodiscard]] inline CursorRange cursor_prefix_range(::mdbx::cursor& cursor, ByteView prefix,
+                                                     CursorMoveDirection direction = CursorMoveDirection::Forward) {
+    return {cursor, prefix, prefix_upper_bound(prefix), direction};
+}
+
+}  // namespace zen::db
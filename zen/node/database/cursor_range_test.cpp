@@ -0,0 +1,119 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <zen/core/common/cast.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/cursor_range.hpp>
+
+namespace zen::db {
+
+static_assert(std::ranges::input_range<CursorRange>);
+static_assert(std::ranges::view<CursorRange>);
+
+static std::vector<std::string> keys_of(auto&& range) {
+    std::vector<std::string> ret;
+    for (const auto& [key, value] : range) ret.emplace_back(byte_view_to_string_view(key));
+    return ret;
+}
+
+TEST_CASE("Cursor range", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    RWTxn txn{env};
+    Cursor cursor(txn, {"Codes"});
+
+    for (const std::string_view key : {"AA", "AAA", "AAC", "AB", "ABA", "AC", "B\xff", "B\xff\xff", "C"}) {
+        cursor.upsert(to_slice(key), to_slice(key));
+    }
+
+    SECTION("Whole map") {
+        CHECK(keys_of(cursor_range(cursor)) ==
+              std::vector<std::string>{"AA", "AAA", "AAC", "AB", "ABA", "AC", "B\xff", "B\xff\xff", "C"});
+        CHECK(keys_of(cursor_range(cursor, {}, {}, CursorMoveDirection::Reverse)) ==
+              std::vector<std::string>{"C", "B\xff\xff", "B\xff", "AC", "ABA", "AB", "AAC", "AAA", "AA"});
+    }
+
+    SECTION("Bounds") {
+        const ByteView begin{string_view_to_byte_view("AAB")};
+        const ByteView end{string_view_to_byte_view("AC")};
+        CHECK(keys_of(cursor_range(cursor, begin, end)) == std::vector<std::string>{"AAC", "AB", "ABA"});
+        CHECK(keys_of(cursor_range(cursor, begin, end, CursorMoveDirection::Reverse)) ==
+              std::vector<std::string>{"ABA", "AB", "AAC"});
+
+        // Past the last key
+        const ByteView past{string_view_to_byte_view("D")};
+        CHECK(keys_of(cursor_range(cursor, past)).empty());
+        CHECK(keys_of(cursor_range(cursor, begin, past, CursorMoveDirection::Reverse)).size() == 7);
+
+        // Empty interval
+        CHECK(keys_of(cursor_range(cursor, end, begin)).empty());
+        CHECK(keys_of(cursor_range(cursor, end, begin, CursorMoveDirection::Reverse)).empty());
+    }
+
+    SECTION("Prefix") {
+        const ByteView prefix{string_view_to_byte_view("AA")};
+        CHECK(keys_of(cursor_prefix_range(cursor, prefix)) == std::vector<std::string>{"AA", "AAA", "AAC"});
+        CHECK(keys_of(cursor_prefix_range(cursor, prefix, CursorMoveDirection::Reverse)) ==
+              std::vector<std::string>{"AAC", "AAA", "AA"});
+
+        // Prefix with trailing 0xff
+        const ByteView ff_prefix{string_view_to_byte_view("B\xff")};
+        CHECK(keys_of(cursor_prefix_range(cursor, ff_prefix, CursorMoveDirection::Reverse)) ==
+              std::vector<std::string>{"B\xff\xff", "B\xff"});
+
+        // Same as cursor_for_prefix
+        std::vector<std::string> walked;
+        const auto count{cursor_for_prefix(
+            cursor, prefix, [&](ByteView key, ByteView) { walked.emplace_back(byte_view_to_string_view(key)); },
+            CursorMoveDirection::Reverse)};
+        CHECK(count == 3);
+        CHECK(walked == keys_of(cursor_prefix_range(cursor, prefix, CursorMoveDirection::Reverse)));
+    }
+
+    SECTION("Composition") {
+        auto range{cursor_range(cursor)};
+        auto values{range | std::views::take_while([](const auto& kv) { return kv.first.length() == 2; }) |
+                    std::views::transform([](const auto& kv) { return kv.second; })};
+        std::vector<ByteView> collected;
+        for (const auto value : values) collected.push_back(value);
+        REQUIRE(collected.size() == 1);
+        CHECK(collected[0] == string_view_to_byte_view("AA"));
+
+        auto first{cursor_prefix_range(cursor, string_view_to_byte_view("AB")) | std::views::take(1)};
+        CHECK(keys_of(first) == std::vector<std::string>{"AB"});
+
+        // Early termination leaves the cursor on the last visited record
+        for (const auto& [key, _] : cursor_prefix_range(cursor, string_view_to_byte_view("AB"))) {
+            if (key == string_view_to_byte_view("AB")) break;
+        }
+        CHECK(from_slice(cursor.current().key) == string_view_to_byte_view("AB"));
+    }
+
+    SECTION("Empty map") {
+        Cursor empty(txn, {"Empty"});
+        CHECK(keys_of(cursor_range(empty)).empty());
+        CHECK(keys_of(cursor_range(empty, {}, {}, CursorMoveDirection::Reverse)).empty());
+        CHECK(keys_of(cursor_prefix_range(empty, string_view_to_byte_view("A"))).empty());
+    }
+}
+
+TEST_CASE("Prefix upper bound", "[database]") {
+    CHECK(prefix_upper_bound(ByteView{}).empty());
+    CHECK(prefix_upper_bound(Bytes{0xff, 0xff}).empty());
+    CHECK(prefix_upper_bound(Bytes{0x01, 0x02}) == Bytes{0x01, 0x03});
+    CHECK(prefix_upper_bound(Bytes{0x01, 0xff}) == Bytes{0x02});
+}
+
+}  // namespace zen::db
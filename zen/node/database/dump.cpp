@@ -0,0 +1,361 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "dump.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <zen/core/common/cast.hpp>
+#include <zen/core/common/endian.hpp>
+#include <zen/core/crypto/hash256.hpp>
+#include <zen/core/serialization/serialize.hpp>
+#include <zen/core/serialization/span_stream.hpp>
+
+#include <zen/node/common/directories.hpp>
+
+namespace zen::db {
+
+static constexpr std::array<uint8_t, 4> kMagic{'Z', 'D', 'M', 'P'};
+static constexpr uint16_t kVersion{1};
+static constexpr size_t kChecksumSize{h256::size()};
+static constexpr size_t kTrailerSize{sizeof(uint64_t) + kChecksumSize};
+static constexpr size_t kIoBufferSize{4_MiB};
+static constexpr uint64_t kSafePointInterval{1'024};  // Records appended between safe points
+
+// Flags of a table which are persisted in db (i.e. not MDBX_CREATE and alike)
+static constexpr unsigned kPersistentFlags{MDBX_REVERSEKEY | MDBX_DUPSORT | MDBX_INTEGERKEY | MDBX_DUPFIXED |
+                                           MDBX_INTEGERDUP | MDBX_REVERSEDUP};
+
+[[noreturn]] static void throw_malformed(const std::filesystem::path& path, const std::string& what) {
+    throw std::runtime_error("Malformed dump " + path.string() + " : " + what);
+}
+
+// Buffered writer of a dump file hashing all written data
+class DumpWriter {
+  public:
+    explicit DumpWriter(const std::filesystem::path& path) : path_{path} {
+        file_ = std::fopen(path_.string().c_str(), "wb");
+        if (!file_) throw std::runtime_error("Unable to create " + path_.string());
+        buffer_.reserve(kIoBufferSize);
+    }
+    ~DumpWriter() {
+        if (file_) std::ignore = std::fclose(file_);
+    }
+
+    DumpWriter(const DumpWriter&) = delete;
+    DumpWriter& operator=(const DumpWriter&) = delete;
+
+    void put(ByteView data) {
+        if (buffer_.size() + data.size() > kIoBufferSize) flush();
+        if (data.size() > kIoBufferSize) {
+            write(data);  // Too large to be buffered
+        } else {
+            buffer_.append(data);
+        }
+    }
+
+    void put_compact(uint64_t value) {
+        std::array<uint8_t, sizeof(uint64_t) + 1> bytes{};
+        ser::SpanStream stream{std::span<uint8_t>{bytes.data(), ser::ser_compact_sizeof(value)}};
+        ser::write_compact(stream, value);
+        put(ByteView{bytes.data(), stream.size()});
+    }
+
+    //! \brief Appends the checksum of all data written so far and closes the file
+    DumpStats finish(uint64_t records) {
+        flush();
+        DumpStats ret{.records = records, .bytes = size_ + kChecksumSize, .checksum = h256(hasher_.finalize())};
+        if (std::fwrite(ret.checksum.data(), 1, kChecksumSize, file_) != kChecksumSize || std::fclose(file_) != 0) {
+            file_ = nullptr;
+            throw std::runtime_error("Unable to write " + path_.string());
+        }
+        file_ = nullptr;
+        return ret;
+    }
+
+  private:
+    void flush() {
+        write(buffer_);
+        buffer_.clear();
+    }
+
+    void write(ByteView data) {
+        if (data.empty()) return;
+        hasher_.update(data);
+        if (std::fwrite(data.data(), 1, data.size(), file_) != data.size()) {
+            throw std::runtime_error("Unable to write " + path_.string());
+        }
+        size_ += data.size();
+    }
+
+    const std::filesystem::path path_;
+    std::FILE* file_{nullptr};
+    Bytes buffer_;
+    crypto::Hash256 hasher_;
+    uint64_t size_{0};
+};
+
+// Buffered reader of a dump file hashing all data but the checksum
+class DumpReader {
+  public:
+    explicit DumpReader(const std::filesystem::path& path) : path_{path} {
+        const auto file_size{std::filesystem::file_size(path_)};
+        if (file_size < kMagic.size() + kTrailerSize) throw_malformed(path_, "too short");
+        hashed_size_ = file_size - kChecksumSize;
+        records_end_ = file_size - kTrailerSize;
+        file_ = std::fopen(path_.string().c_str(), "rb");
+        if (!file_) throw std::runtime_error("Unable to open " + path_.string());
+        buffer_.resize(kIoBufferSize);
+    }
+    ~DumpReader() {
+        if (file_) std::ignore = std::fclose(file_);
+    }
+
+    DumpReader(const DumpReader&) = delete;
+    DumpReader& operator=(const DumpReader&) = delete;
+
+    //! \brief Whether all records have been read
+    [[nodiscard]] bool records_done() const noexcept { return consumed_ >= records_end_; }
+
+    //! \brief Returns a view on the next count bytes : valid until next call
+    ByteView take(size_t count) {
+        if (count > hashed_size_ - consumed_) throw_malformed(path_, "truncated");
+        if (end_ - pos_ < count) refill(count);
+        const ByteView ret{&buffer_[pos_], count};
+        pos_ += count;
+        consumed_ += count;
+        return ret;
+    }
+
+    uint64_t take_compact() {
+        const uint8_t prefix{take(1)[0]};
+        switch (prefix) {
+            case 253:
+                return endian::load_little_u16(take(sizeof(uint16_t)).data());
+            case 254:
+                return endian::load_little_u32(take(sizeof(uint32_t)).data());
+            case 255:
+                return endian::load_little_u64(take(sizeof(uint64_t)).data());
+            default:
+                return prefix;
+        }
+    }
+
+    //! \brief Reads the trailer and verifies records count and checksum
+    h256 finish(uint64_t records) {
+        if (consumed_ != records_end_) throw_malformed(path_, "records overrun trailer");
+        if (endian::load_little_u64(take(sizeof(uint64_t)).data()) != records) {
+            throw_malformed(path_, "records count mismatch");
+        }
+        std::array<uint8_t, kChecksumSize> checksum{};
+        if (std::fread(checksum.data(), 1, checksum.size(), file_) != checksum.size()) {
+            throw std::runtime_error("Unable to read " + path_.string());
+        }
+        const h256 ret{hasher_.finalize()};
+        if (std::memcmp(ret.data(), checksum.data(), checksum.size()) != 0) throw_malformed(path_, "bad checksum");
+        return ret;
+    }
+
+  private:
+    void refill(size_t count) {
+        // Move unread data in front and make room for count bytes
+        std::memmove(buffer_.data(), &buffer_[pos_], end_ - pos_);
+        end_ -= pos_;
+        pos_ = 0;
+        if (buffer_.size() < count) buffer_.resize(count);
+
+        const auto to_read{std::min<uint64_t>(buffer_.size() - end_, hashed_size_ - read_)};
+        const auto read{std::fread(&buffer_[end_], 1, static_cast<size_t>(to_read), file_)};
+        hasher_.update(ByteView{&buffer_[end_], read});
+        end_ += read;
+        read_ += read;
+        if (end_ < count) throw std::runtime_error("Unable to read " + path_.string());
+    }
+
+    const std::filesystem::path path_;
+    std::FILE* file_{nullptr};
+    Bytes buffer_;
+    size_t pos_{0};            // Read position in buffer
+    size_t end_{0};            // End of data in buffer
+    uint64_t read_{0};         // Bytes read from file
+    uint64_t consumed_{0};     // Bytes handed out
+    uint64_t hashed_size_{0};  // Bytes covered by the checksum
+    uint64_t records_end_{0};  // End of records
+    crypto::Hash256 hasher_;
+};
+
+// Appends all records fed in key order into the table cursor is bound to, committing at safe points
+static uint64_t append_records(RWTxn& txn, Cursor& cursor, const MapConfig& config, size_t batch_size,
+                               FeedFuncRef feeder) {
+    txn.set_dirty_budget(batch_size);
+    uint64_t ret{0};
+    ByteView key;
+    ByteView value;
+    while (feeder(key, value)) {
+        std::ignore = cursor_append(cursor, key, value);
+        if (++ret % kSafePointInterval == 0 && txn.safe_point()) cursor.bind(txn, config);
+    }
+    return ret;
+}
+
+static void ensure_empty(Cursor& cursor, const MapConfig& config) {
+    if (cursor.get_map_stat().ms_entries) {
+        throw std::logic_error("Table " + std::string(config.name) + " must be empty to be restored");
+    }
+}
+
+std::filesystem::path dump_file_name(const MapConfig& config) { return std::string(config.name) + ".dump"; }
+
+DumpStats dump_table(::mdbx::txn& txn, const MapConfig& config, const std::filesystem::path& path) {
+    Cursor cursor(txn, config);
+    const std::string_view name{config.name};
+    if (name.size() > std::numeric_limits<uint16_t>::max()) throw std::invalid_argument("Table name too long");
+
+    DumpWriter writer(path);
+    std::array<uint8_t, sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint16_t)> header{};
+    endian::store_little_u16(&header[0], kVersion);
+    endian::store_little_u32(&header[2], cursor.get_map_flags() & kPersistentFlags);
+    endian::store_little_u16(&header[6], static_cast<uint16_t>(name.size()));
+    writer.put(ByteView{kMagic.data(), kMagic.size()});
+    writer.put(ByteView{header.data(), header.size()});
+    writer.put(string_view_to_byte_view(name));
+
+    uint64_t records{0};
+    for (auto data{cursor.to_first(/*throw_notfound=*/false)}; data; data = cursor.to_next(/*throw_notfound=*/false)) {
+        writer.put_compact(data.key.length());
+        writer.put(from_slice(data.key));
+        writer.put_compact(data.value.length());
+        writer.put(from_slice(data.value));
+        ++records;
+    }
+
+    std::array<uint8_t, sizeof(uint64_t)> count{};
+    endian::store_little_u64(count.data(), records);
+    writer.put(ByteView{count.data(), count.size()});
+    return writer.finish(records);
+}
+
+std::vector<DumpStats> dump_tables(::mdbx::txn& txn, std::span<const MapConfig> tables,
+                                   const std::filesystem::path& directory) {
+    std::filesystem::create_directories(directory);
+    std::vector<DumpStats> ret;
+    ret.reserve(tables.size());
+    for (const auto& table : tables) ret.push_back(dump_table(txn, table, directory / dump_file_name(table)));
+    return ret;
+}
+
+DumpStats restore_table(RWTxn& txn, const MapConfig& config, const std::filesystem::path& path, size_t batch_size) {
+    DumpReader reader(path);
+    if (std::memcmp(reader.take(kMagic.size()).data(), kMagic.data(), kMagic.size()) != 0) {
+        throw_malformed(path, "bad magic");
+    }
+    const auto header{reader.take(sizeof(uint16_t) + sizeof(uint32_t) + sizeof(uint16_t))};
+    if (endian::load_little_u16(&header[0]) != kVersion) throw_malformed(path, "unsupported version");
+    const uint32_t flags{endian::load_little_u32(&header[2])};
+    const std::string name{byte_view_to_string_view(reader.take(endian::load_little_u16(&header[6])))};
+    if (name != config.name) {
+        throw std::runtime_error("Dump of table " + name + " can't be restored into " + config.name);
+    }
+
+    Cursor cursor(txn, config);
+    ensure_empty(cursor, config);
+    if ((cursor.get_map_flags() & kPersistentFlags) != flags) {
+        throw std::runtime_error("Table " + name + " flags do not match those of the dump");
+    }
+
+    Bytes key_buffer;
+    const auto records{append_records(txn, cursor, config, batch_size, [&](ByteView& key, ByteView& value) {
+        if (reader.records_done()) return false;
+        key_buffer.assign(reader.take(reader.take_compact()));  // Copied as next take invalidates the view
+        key = key_buffer;
+        value = reader.take(reader.take_compact());
+        return true;
+    })};
+    return {.records = records, .bytes = std::filesystem::file_size(path), .checksum = reader.finish(records)};
+}
+
+std::vector<DumpStats> restore_tables(::mdbx::env& env, std::span<const MapConfig> tables,
+                                      const std::filesystem::path& directory, const RestoreConfig& config) {
+    {
+        // Fail early on non empty tables
+        RWTxn txn{env};
+        for (const auto& table : tables) {
+            Cursor cursor(txn, table);
+            ensure_empty(cursor, table);
+        }
+        txn.commit(/*renew=*/false);
+    }
+
+    // Load each dump in its own staging environment
+    const auto staging_root{config.staging_directory.empty()
+                                ? std::make_unique<TempDirectory>()
+                                : std::make_unique<TempDirectory>(config.staging_directory)};
+    std::vector<std::optional<::mdbx::env_managed>> staged(tables.size());
+    std::vector<DumpStats> ret(tables.size());
+    std::vector<std::exception_ptr> exceptions(tables.size());
+    std::atomic_size_t next_table{0};
+    const auto stage_tables{[&]() {
+        for (size_t i{next_table++}; i < tables.size(); i = next_table++) {
+            try {
+                EnvConfig staging_config{(staging_root->path() / tables[i].name).string(), /*create=*/true};
+                staging_config.page_size = env.get_pagesize();
+                staging_config.durability = DurabilityMode::kLazy;  // Throwaway data
+                staged[i].emplace(open_env(staging_config));
+                RWTxn txn{*staged[i]};
+                ret[i] = restore_table(txn, tables[i], directory / dump_file_name(tables[i]), config.batch_size);
+                txn.commit(/*renew=*/false);
+            } catch (...) {
+                exceptions[i] = std::current_exception();
+            }
+        }
+    }};
+
+    // The calling thread takes its share : tables not picked up by other threads are staged by it
+    std::vector<std::thread> threads;
+    const auto threads_count{std::min(tables.size(), parallel_scan_threads(config.max_threads))};
+    threads.reserve(threads_count);
+    try {
+        for (size_t t{1}; t < threads_count; ++t) threads.emplace_back(stage_tables);
+    } catch (...) {
+        // Out of threads (e.g. resource limits) : go on with the ones started
+    }
+    stage_tables();
+    for (auto& thread : threads) thread.join();
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+
+    // Merge : records are already sorted hence appended
+    for (size_t i{0}; i < tables.size(); ++i) {
+        auto source_txn{staged[i]->start_read()};
+        Cursor source(source_txn, tables[i]);
+        RWTxn txn{env};
+        Cursor target(txn, tables[i]);
+        auto data{source.to_first(/*throw_notfound=*/false)};
+        std::ignore = append_records(txn, target, tables[i], config.batch_size, [&](ByteView& key, ByteView& value) {
+            if (!data) return false;
+            key = from_slice(data.key);
+            value = from_slice(data.value);
+            data = source.to_next(/*throw_notfound=*/false);
+            return true;
+        });
+        txn.commit(/*renew=*/false);
+    }
+    return ret;
+}
+
+}  // namespace zen::db
@@ -0,0 +1,78 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include <zen/core/common/base.hpp>
+#include <zen/core/types/hash.hpp>
+
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+/*
+ * Table dumps are flat files holding all the records of a table in key order, meant to bootstrap a node with a
+ * compact database (no free pages nor fragmentation, unlike a copy of the data file) much faster than re-syncing.
+ *
+ * Layout (integers are little endian)
+ *   Header  : magic "ZDMP" | version u16 | table flags u32 (MDBX_db_flags_t) | name length u16 | name
+ *   Records : key length (compact size) | key | value length (compact size) | value
+ *   Trailer : records count u64 | checksum (Hash256 of all preceding bytes)
+ */
+
+//! \brief Outcome of a table dump or restore
+struct DumpStats {
+    uint64_t records{0};  // Number of records
+    uint64_t bytes{0};    // Size of the dump file
+    h256 checksum{};      // Checksum of the dump file
+};
+
+//! \brief Settings of tables restore
+struct RestoreConfig {
+    size_t batch_size{512_MiB};                 // Max dirty data before committing (see RWTxn::set_dirty_budget)
+    size_t max_threads{0};                      // Max tables restored concurrently (0 = hardware concurrency)
+    std::filesystem::path staging_directory{};  // Where staging environments are created (empty = OS temp path)
+};
+
+//! \brief Returns the name of the dump file of a table
+[[nodiscard]] std::filesystem::path dump_file_name(const MapConfig& config);
+
+//! \brief Writes all the records of a table to a dump file
+//! \param [in] txn : A transaction (records are those of its snapshot)
+//! \param [in] config : The table to dump
+//! \param [in] path : The dump file (overwritten if existing)
+//! \throws std::runtime_error on I/O errors
+DumpStats dump_table(::mdbx::txn& txn, const MapConfig& config, const std::filesystem::path& path);
+
+//! \brief Dumps tables into a directory : one file per table (see dump_file_name), all from the same snapshot
+std::vector<DumpStats> dump_tables(::mdbx::txn& txn, std::span<const MapConfig> tables,
+                                   const std::filesystem::path& directory);
+
+//! \brief Loads a dump file into an empty table with append-mode inserts
+//! \param [in] txn : A write transaction : it's committed each time dirty data exceed batch_size and must be
+//! committed by the caller when done
+//! \param [in] config : The table to restore (flags must match those of the dumped table)
+//! \param [in] path : The dump file
+//! \param [in] batch_size : Max dirty data before committing
+//! \throws std::logic_error when the table is not empty, std::runtime_error when the dump is malformed or its
+//! checksum does not match
+//! \remarks The checksum is verified once all records are read : on failure records may have been committed, hence
+//! restores are meant for new environments to be discarded on failure
+DumpStats restore_table(RWTxn& txn, const MapConfig& config, const std::filesystem::path& path,
+                        size_t batch_size = 512_MiB);
+
+//! \brief Restores tables from the dump files in directory (see dump_tables) into a new environment
+//! \details Dumps are decoded, verified and loaded concurrently, each in a separate staging environment (mdbx only
+//! allows one writer at a time), then merged into env by appending their records in key order
+//! \throws Same as restore_table. All tables are verified before any is merged into env
+std::vector<DumpStats> restore_tables(::mdbx::env& env, std::span<const MapConfig> tables,
+                                      const std::filesystem::path& directory, const RestoreConfig& config = {});
+
+}  // namespace zen::db
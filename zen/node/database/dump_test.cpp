@@ -0,0 +1,120 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <array>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <zen/core/common/cast.hpp>
+#include <zen/core/common/endian.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/dump.hpp>
+
+namespace zen::db {
+
+static const MapConfig kPlainTable{"Plain"};
+static const MapConfig kMultiTable{"Multi", ::mdbx::key_mode::usual, ::mdbx::value_mode::multi};
+static const std::array<MapConfig, 2> kTables{kPlainTable, kMultiTable};
+
+using Records = std::vector<std::pair<Bytes, Bytes>>;
+
+static Records read_all(::mdbx::txn& txn, const MapConfig& config) {
+    Records ret;
+    Cursor cursor(txn, config);
+    cursor_for_each(cursor, [&ret](ByteView key, ByteView value) { ret.emplace_back(key, value); });
+    return ret;
+}
+
+static ::mdbx::env_managed open_test_env(const TempDirectory& tmp_dir, const std::string& name) {
+    EnvConfig db_config{(tmp_dir.path() / name).string(), /*create*/ true};
+    db_config.inmemory = true;
+    return open_env(db_config);
+}
+
+TEST_CASE("Table dump and restore", "[database]") {
+    const TempDirectory tmp_dir;
+    const auto dump_directory{tmp_dir.path() / "dumps"};
+    auto source_env{open_test_env(tmp_dir, "source")};
+    {
+        RWTxn txn{source_env};
+        Cursor plain(txn, kPlainTable);
+        Cursor multi(txn, kMultiTable);
+        Bytes key(sizeof(uint64_t), 0);
+        for (uint64_t i{0}; i < 3'000; ++i) {
+            endian::store_big_u64(key.data(), i * 7);
+            plain.upsert(to_slice(key), to_slice(Bytes(i % 300, static_cast<uint8_t>(i))));
+            for (uint8_t j{0}; j < i % 4; ++j) multi.upsert(to_slice(key), to_slice(Bytes(4, j)));
+        }
+        plain.upsert(to_slice(string_view_to_byte_view("")), to_slice(string_view_to_byte_view("empty key")));
+        plain.upsert(to_slice(string_view_to_byte_view("large")), to_slice(Bytes(5_MiB, 0xab)));  // Unbuffered
+        txn.commit(/*renew=*/false);
+    }
+
+    std::vector<DumpStats> dumped;
+    Records plain_records;
+    Records multi_records;
+    {
+        auto txn{source_env.start_read()};
+        dumped = dump_tables(txn, kTables, dump_directory);
+        plain_records = read_all(txn, kPlainTable);
+        multi_records = read_all(txn, kMultiTable);
+    }
+    REQUIRE(dumped.size() == 2);
+    CHECK(dumped[0].records == plain_records.size());
+    CHECK(dumped[1].records == multi_records.size());
+    CHECK(dumped[0].bytes == std::filesystem::file_size(dump_directory / dump_file_name(kPlainTable)));
+
+    SECTION("Parallel restore") {
+        auto target_env{open_test_env(tmp_dir, "target")};
+        const RestoreConfig config{.batch_size = 1_MiB, .max_threads = 2, .staging_directory = tmp_dir.path()};
+        const auto restored{restore_tables(target_env, kTables, dump_directory, config)};
+        REQUIRE(restored.size() == 2);
+        for (size_t i{0}; i < restored.size(); ++i) {
+            CHECK(restored[i].records == dumped[i].records);
+            CHECK(restored[i].checksum == dumped[i].checksum);
+        }
+        auto txn{target_env.start_read()};
+        CHECK(read_all(txn, kPlainTable) == plain_records);
+        CHECK(read_all(txn, kMultiTable) == multi_records);
+    }
+
+    SECTION("Single table restore") {
+        auto target_env{open_test_env(tmp_dir, "target")};
+        RWTxn txn{target_env};
+        const auto restored{restore_table(txn, kMultiTable, dump_directory / dump_file_name(kMultiTable))};
+        CHECK(restored.checksum == dumped[1].checksum);
+        CHECK(read_all(*txn, kMultiTable) == multi_records);
+
+        // Target must be empty
+        CHECK_THROWS_AS(restore_table(txn, kMultiTable, dump_directory / dump_file_name(kMultiTable)),
+                        std::logic_error);
+        // Dump must be of the same table
+        CHECK_THROWS_AS(restore_table(txn, kPlainTable, dump_directory / dump_file_name(kMultiTable)),
+                        std::runtime_error);
+    }
+
+    SECTION("Corrupted dump") {
+        const auto path{dump_directory / dump_file_name(kPlainTable)};
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(std::filesystem::file_size(path) / 2));
+            file.put('\x5a');
+        }
+        auto target_env{open_test_env(tmp_dir, "target")};
+        RWTxn txn{target_env};
+        CHECK_THROWS_AS(restore_table(txn, kPlainTable, path), std::runtime_error);
+
+        std::filesystem::resize_file(path, 10);
+        CHECK_THROWS_AS(restore_table(txn, kPlainTable, path), std::runtime_error);
+    }
+}
+
+}  // namespace zen::db
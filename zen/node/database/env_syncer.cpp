@@ -0,0 +1,79 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "env_syncer.hpp"
+
+#include <mutex>
+
+#include <zen/node/common/log.hpp>
+#include <zen/node/concurrency/ossignals.hpp>
+
+namespace zen::db {
+
+EnvSyncer::EnvSyncer(::mdbx::env env, const EnvConfig& config)
+    : EnvSyncer(env, std::chrono::seconds(config.sync_period_seconds), config.sync_threshold) {}
+
+EnvSyncer::EnvSyncer(::mdbx::env env, std::chrono::milliseconds period, size_t threshold)
+    : Worker("env-syncer"), env_{env}, period_{period}, threshold_{threshold} {}
+
+EnvSyncer::~EnvSyncer() { std::ignore = EnvSyncer::stop(/*wait=*/true); }
+
+bool EnvSyncer::stop(bool wait) noexcept {
+    const auto ret{Worker::stop(wait)};
+    if (wait) {
+        try {
+            if (unsynced_bytes()) sync();
+        } catch (const std::exception& ex) {
+            std::ignore = log::Error("Final sync failed", {"name", name_, "exception", ex.what()});
+        }
+    }
+    return ret;
+}
+
+void EnvSyncer::sync() {
+    std::ignore = env_.sync_to_disk(/*force=*/true, /*nonblock=*/false);
+    ++syncs_count_;
+}
+
+uint64_t EnvSyncer::unsynced_bytes() const {
+    MDBX_envinfo info;
+    ::mdbx::error::success_or_throw(::mdbx_env_info_ex(env_, nullptr, &info, sizeof(info)));
+    return info.mi_unsync_volume;
+}
+
+void EnvSyncer::work() {
+    using namespace std::chrono;
+    auto last_sync_time{steady_clock::now()};
+    bool signal_handled{false};
+
+    while (!is_stopping()) {
+        {
+            std::unique_lock lock(kick_mtx_);
+            std::ignore = kicked_cv_.wait_for(lock, kPollInterval, [this] { return kicked_.load() || is_stopping(); });
+            kicked_.store(false);
+        }
+        if (is_stopping()) break;
+
+        const auto unsynced{unsynced_bytes()};
+        if (!unsynced) {
+            last_sync_time = steady_clock::now();
+            continue;
+        }
+
+        bool sync_due{unsynced >= threshold_ || steady_clock::now() - last_sync_time >= period_};
+        if (!signal_handled && Ossignals::signalled()) {
+            // Shutting down : don't wait for thresholds
+            signal_handled = true;
+            sync_due = true;
+        }
+        if (sync_due) {
+            sync();
+            last_sync_time = steady_clock::now();
+        }
+    }
+}
+
+}  // namespace zen::db
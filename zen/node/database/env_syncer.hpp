@@ -0,0 +1,50 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+
+#include <zen/node/concurrency/worker.hpp>
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+//! \brief Background worker syncing to disk the data committed on an environment with lazy durability
+//! (see DurabilityMode::kLazy). This takes fsync out of the commit path : a sync happens when either the configured
+//! period has elapsed or the amount of unsynced data exceeds the configured threshold.
+//! \remarks On OS signals (see Ossignals) a sync is forced immediately. A final sync is carried out on stop hence
+//! the syncer must be stopped before the environment is closed
+class EnvSyncer final : public Worker {
+  public:
+    explicit EnvSyncer(::mdbx::env env, const EnvConfig& config);
+    EnvSyncer(::mdbx::env env, std::chrono::milliseconds period, size_t threshold);
+    ~EnvSyncer() override;
+
+    //! \brief Stops the worker thread and syncs data not yet synced
+    bool stop(bool wait) noexcept override;
+
+    //! \brief Syncs to disk all committed data
+    void sync();
+
+    //! \brief Number of syncs carried out
+    [[nodiscard]] uint64_t syncs_count() const noexcept { return syncs_count_.load(); }
+
+  private:
+    //! \brief Amount of data committed but not yet synced
+    [[nodiscard]] uint64_t unsynced_bytes() const;
+
+    void work() override;
+
+    static constexpr std::chrono::milliseconds kPollInterval{100};
+
+    ::mdbx::env env_;
+    const std::chrono::milliseconds period_;
+    const size_t threshold_;
+    std::atomic_uint64_t syncs_count_{0};
+};
+
+}  // namespace zen::db
@@ -0,0 +1,77 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <chrono>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/env_syncer.hpp>
+
+namespace zen::db {
+
+static uint64_t get_unsynced_bytes(const ::mdbx::env& env) {
+    MDBX_envinfo info;
+    ::mdbx::error::success_or_throw(::mdbx_env_info_ex(env, nullptr, &info, sizeof(info)));
+    return info.mi_unsync_volume;
+}
+
+static void write_some_data(::mdbx::env& env) {
+    RWTxn txn(env);
+    Cursor cursor(txn, {"Data"});
+    const Bytes value(4_KiB, 0xaa);
+    for (uint8_t i{0}; i < 16; ++i) {
+        cursor.upsert(to_slice(Bytes{i}), to_slice(value));
+    }
+    txn.commit(/*renew=*/false);
+}
+
+static bool wait_for_syncs(const EnvSyncer& syncer, uint64_t count) {
+    for (int i{0}; i < 100 && syncer.syncs_count() < count; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    return syncer.syncs_count() >= count;
+}
+
+TEST_CASE("Environment syncer", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.durability = DurabilityMode::kLazy;
+    auto env{db::open_env(db_config)};
+
+    // Commits are not synced
+    write_some_data(env);
+    CHECK(get_unsynced_bytes(env) != 0);
+
+    SECTION("By threshold") {
+        EnvSyncer syncer(env, std::chrono::hours(1), /*threshold=*/1);
+        syncer.start(/*kicked=*/false, /*wait=*/true);
+        CHECK(wait_for_syncs(syncer, 1));
+        CHECK(get_unsynced_bytes(env) == 0);
+        syncer.stop(/*wait=*/true);
+    }
+
+    SECTION("By period") {
+        EnvSyncer syncer(env, std::chrono::milliseconds(200), /*threshold=*/1_GiB);
+        syncer.start(/*kicked=*/false, /*wait=*/true);
+        CHECK(wait_for_syncs(syncer, 1));
+        write_some_data(env);
+        CHECK(wait_for_syncs(syncer, 2));
+        syncer.stop(/*wait=*/true);
+    }
+
+    SECTION("Final sync on stop") {
+        EnvSyncer syncer(env, db_config);
+        syncer.start(/*kicked=*/false, /*wait=*/true);
+        write_some_data(env);
+        syncer.stop(/*wait=*/true);
+        CHECK(get_unsynced_bytes(env) == 0);
+        CHECK(syncer.syncs_count() == 1);
+    }
+}
+
+}  // namespace zen::db
@@ -7,8 +7,19 @@
 
 #include "mdbx.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <latch>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
+#include "zen/core/common/endian.hpp"
+#include "zen/core/common/memory.hpp"
 #include "zen/core/common/misc.hpp"
 
 namespace zen::db {
@@ -39,11 +50,193 @@ static inline mdbx::cursor::move_result strict_lower_bound(mdbx::cursor& cursor,
     return cursor.to_previous(/*throw_notfound=*/false);
 }
 
+// Last entry whose key is less than all keys past the given prefix (the caller must check the prefix matches)
+static inline mdbx::cursor::move_result last_with_prefix(mdbx::cursor& cursor, const ByteView prefix) {
+    const auto upper_bound{prefix_upper_bound(prefix)};
+    return upper_bound.empty() ? cursor.to_last(/*throw_notfound=*/false) : strict_lower_bound(cursor, upper_bound);
+}
+
 static inline mdbx::cursor::move_operation move_operation(CursorMoveDirection direction) {
     return direction == CursorMoveDirection::Forward ? mdbx::cursor::move_operation::next
                                                      : mdbx::cursor::move_operation::previous;
 }
 
+static inline bool is_multi_value(::mdbx::cursor& cursor) {
+    return cursor.txn().get_handle_info(cursor.map()).flags & MDBX_DUPSORT;
+}
+
+// Whether keys of the map the cursor is bound to are ordered as plain byte strings
+static inline bool is_usual_collation(::mdbx::cursor& cursor) {
+    return (cursor.txn().get_handle_info(cursor.map()).flags & (MDBX_REVERSEKEY | MDBX_INTEGERKEY)) == 0;
+}
+
+// Erases the record the cursor is positioned on (along with all the values of the key on multi-value maps by means of
+// MDBX_ALLDUPS) and returns the number of erased records
+static inline size_t erase_current(::mdbx::cursor& cursor, bool multi_value) {
+    const size_t count{multi_value ? cursor.count_multivalue() : 1};
+    std::ignore = cursor.erase(/*whole_multivalue=*/multi_value);
+    return count;
+}
+
+// Compares two keys by the collation of the map the cursor is bound to
+static inline int compare_keys(::mdbx::cursor& cursor, const ::mdbx::slice& lhs, const ::mdbx::slice& rhs) {
+    return ::mdbx_cmp(::mdbx_cursor_txn(cursor), ::mdbx_cursor_dbi(cursor), &lhs, &rhs);
+}
+
+// Empties the map the cursor is bound to at once and returns the number of erased records
+static inline size_t clear_whole_map(::mdbx::cursor& cursor) {
+    auto txn{cursor.txn()};
+    const auto entries{txn.get_map_stat(cursor.map()).ms_entries};
+    txn.clear_map(cursor.map());
+    return entries;
+}
+
+// Put flags to append records to the map the cursor is bound to
+static inline MDBX_put_flags_t append_flags(::mdbx::cursor& cursor) {
+    return is_multi_value(cursor) ? MDBX_APPEND | MDBX_APPENDDUP : MDBX_APPEND;
+}
+
+// Tries to append the record and falls back to upsert if it's out of order
+static inline bool append_or_upsert(::mdbx::cursor& cursor, const ByteView key, const ByteView value,
+                                    const MDBX_put_flags_t flags) {
+    const mdbx::slice key_slice{to_slice(key)};
+    mdbx::slice value_slice{to_slice(value)};
+    const auto rc{cursor.put(key_slice, &value_slice, flags)};
+    if (rc == MDBX_SUCCESS) return true;
+    if (rc != MDBX_EKEYMISMATCH) ::mdbx::error::success_or_throw(rc);
+
+    value_slice = to_slice(value);
+    ::mdbx::error::success_or_throw(cursor.put(key_slice, &value_slice, MDBX_UPSERT));
+    return false;
+}
+
+// Sequence of unique ids tagging the environments opened by open_env
+static std::atomic_uintptr_t env_id_sequence{0};
+
+// A map handle resolved on an environment
+struct CachedMapHandle {
+    uintptr_t env_id{0};
+    std::string name;
+    ::mdbx::map_handle handle;
+};
+
+static constexpr size_t kMaxCachedMapHandles{256};
+static thread_local std::vector<CachedMapHandle> cached_map_handles_{};
+
+ROTxn::~ROTxn() {
+    if (pool_ && static_cast<const MDBX_txn*>(managed_txn_) != nullptr) {
+        pool_->release(std::move(managed_txn_), std::move(cursors_));
+    }
+}
+
+::mdbx::cursor& ROTxn::cursor(const MapConfig& config) {
+    const std::string_view name{config.name ? config.name : ""};
+    for (auto& [cursor_name, cursor] : cursors_) {
+        if (cursor_name == name) return cursor;
+    }
+    return cursors_.emplace_back(std::string{name}, open_cursor(operator*(), config)).second;
+}
+
+// Converts a duration expressed in 1/65536 of second (as reported by mdbx_txn_commit_ex) to microseconds
+static inline std::chrono::microseconds from_16dot16(uint32_t value) {
+    return std::chrono::microseconds((static_cast<uint64_t>(value) * 1'000'000U) >> 16);
+}
+
+void RWTxn::commit(const bool renew) {
+    /*
+     * renew is required here due to RAII
+     * RWTxn txn(env);
+     * txn.commit();
+     * env.close();
+     * causes a segfault for tx being aborted when the env is already closed
+     *
+     * Workarounds
+     * - either pass renew==false to last commit
+     * - or keep RWTxn in a lower scope
+     * */
+    if (external_txn_ != nullptr) return;
+
+    cursors_.clear();
+    MDBX_txn_info info;
+    ::mdbx::error::success_or_throw(::mdbx_txn_info(managed_txn_, &info, /*scan_rlt=*/false));
+    mdbx::env env = managed_txn_.env();
+    MDBX_commit_latency latency{};
+    managed_txn_.commit(&latency);
+    last_commit_stats_ = {.dirty_bytes = info.txn_space_dirty,
+                          .preparation = from_16dot16(latency.preparation),
+                          .gc = from_16dot16(latency.gc_wallclock),
+                          .write = from_16dot16(latency.write),
+                          .sync = from_16dot16(latency.sync),
+                          .whole = from_16dot16(latency.whole)};
+    if (renew) {
+        managed_txn_ = env.start_write();  // renew transaction
+    }
+}
+
+bool RWTxn::safe_point() {
+    if (!dirty_budget_ || external_txn_) return false;
+
+    MDBX_txn_info info;
+    ::mdbx::error::success_or_throw(::mdbx_txn_info(managed_txn_, &info, /*scan_rlt=*/false));
+    // txn_space_leftover is the room left for dirty pages before reaching txn_dp_limit
+    const bool over_budget{info.txn_space_dirty >= dirty_budget_};
+    const bool low_room{info.txn_space_leftover < (info.txn_space_dirty + info.txn_space_leftover) / 8};
+    if (!over_budget && !low_room) return false;
+
+    commit(/*renew=*/true);
+    ++sub_commits_;
+    return true;
+}
+
+ROTxnPool::ROTxnPool(const mdbx::env& env, size_t max_parked)
+    : env_{env},
+      max_parked_{std::min(max_parked ? max_parked : env.max_readers() / 4,
+                           static_cast<size_t>(std::max(env.max_readers(), 1U) - 1))} {
+    parked_.reserve(max_parked_);
+}
+
+ROTxnPool::~ROTxnPool() {
+    std::scoped_lock lock{mutex_};
+    parked_.clear();
+}
+
+ROTxn ROTxnPool::acquire() {
+    std::unique_lock lock{mutex_};
+    while (!parked_.empty()) {
+        ParkedTxn parked{std::move(parked_.back())};
+        parked_.pop_back();
+        lock.unlock();
+        try {
+            parked.txn.renew_reading();
+            for (auto& [_, cursor] : parked.cursors) cursor.renew(parked.txn);
+            ++hits_;
+            return ROTxn{std::move(parked.txn), std::move(parked.cursors), this};
+        } catch (const mdbx::exception&) {
+            // Parked transaction not renewable : drop it and try with next one
+        }
+        lock.lock();
+    }
+    lock.unlock();
+    ++misses_;
+    return ROTxn{env_.start_read(), {}, this};
+}
+
+size_t ROTxnPool::size() const {
+    std::scoped_lock lock{mutex_};
+    return parked_.size();
+}
+
+void ROTxnPool::release(mdbx::txn_managed&& txn, ROTxn::CachedCursors&& cursors) noexcept {
+    try {
+        std::scoped_lock lock{mutex_};
+        if (parked_.size() >= max_parked_) return;  // Transaction and cursors destroyed (aborted) on exit
+        txn.reset_reading();
+        parked_.push_back({std::move(txn), std::move(cursors)});
+    } catch (...) {
+        // Should reset fail the transaction is aborted
+    }
+}
+
 ::mdbx::env_managed open_env(const EnvConfig& config) {
     namespace fs = std::filesystem;
 
@@ -108,6 +301,10 @@ static inline mdbx::cursor::move_operation move_operation(CursorMoveDirection di
     if (config.write_map) {
         flags |= MDBX_WRITEMAP;
     }
+    if (config.durability == DurabilityMode::kLazy) {
+        // Last commits might be lost on a system crash but the database stays consistent (no weak tail)
+        flags |= MDBX_SAFE_NOSYNC;
+    }
 
     ::mdbx::env_managed::create_parameters cp{};  // Default create parameters
     if (!config.shared) {
@@ -127,7 +324,8 @@ static inline mdbx::cursor::move_operation move_operation(CursorMoveDirection di
     op.max_readers = config.max_readers;
 
     ::mdbx::env_managed ret{db_path.native(), cp, op, config.shared};
-    if (size_t db_page_size{ret.get_pagesize()}; db_page_size != config.page_size) {
+    // In shared mode the page size is the one of the process which created the environment
+    if (size_t db_page_size{ret.get_pagesize()}; !config.shared && db_page_size != config.page_size) {
         throw std::length_error(
             "Incompatible page size. "
             "Requested " +
@@ -135,16 +333,14 @@ static inline mdbx::cursor::move_operation move_operation(CursorMoveDirection di
     }
 
     if (!config.shared) {
-        // C++ bindings don't have setoptions
-        ::mdbx::error::success_or_throw(::mdbx_env_set_option(ret, MDBX_opt_rp_augment_limit, 32_MiB));
-        if (!config.readonly) {
-            ::mdbx::error::success_or_throw(::mdbx_env_set_option(ret, MDBX_opt_txn_dp_initial, 16_KiB));
-            ::mdbx::error::success_or_throw(::mdbx_env_set_option(ret, MDBX_opt_dp_reserve_limit, 16_KiB));
-
+        if (!config.readonly && !config.auto_tuning && !config.tuning.txn_dp_limit) {
+            // Double mdbx's default
             uint64_t dirty_pages_limit{0};
             ::mdbx::error::success_or_throw(::mdbx_env_get_option(ret, MDBX_opt_txn_dp_limit, &dirty_pages_limit));
             ::mdbx::error::success_or_throw(::mdbx_env_set_option(ret, MDBX_opt_txn_dp_limit, dirty_pages_limit * 2));
-
+        }
+        tune_env(ret, config);
+        if (!config.readonly) {
             // must be in the range from 12.5% (almost empty) to 50% (half empty)
             // which corresponds to the range from 8192 and to 32768 in units respectively
             ::mdbx::error::success_or_throw(
@@ -154,9 +350,74 @@ static inline mdbx::cursor::move_operation move_operation(CursorMoveDirection di
     if (!config.inmemory) {
         ret.check_readers();
     }
+
+    // Tag the environment with a unique id so cached map handles can't be mistaken across environments
+    ::mdbx::error::success_or_throw(::mdbx_env_set_userctx(ret, reinterpret_cast<void*>(++env_id_sequence)));
+    return ret;
+}
+
+EnvTuning auto_env_tuning(size_t physical_memory, size_t batch_size, size_t page_size, SyncPhase phase) {
+    EnvTuning ret{};
+    if (!physical_memory || !page_size) return ret;
+
+    const bool bulk{phase == SyncPhase::kBulk};
+
+    // Dirty pages : 25% headroom over the batch so safe points commit before mdbx has to spill, capped to a share of
+    // physical memory (smaller at tip where the page cache serves readers)
+    const size_t memory_cap{std::max<size_t>(physical_memory / (bulk ? 4U : 8U), 32_MiB)};
+    const size_t dirty_bytes{std::clamp<size_t>(batch_size + batch_size / 4, 32_MiB, memory_cap)};
+    ret.txn_dp_limit = dirty_bytes / page_size;
+    ret.txn_dp_initial =
+        std::min<uint64_t>(bulk ? std::clamp<uint64_t>(ret.txn_dp_limit / 16, 1_KiB, 64_KiB) : 1_KiB, ret.txn_dp_limit);
+    ret.dp_reserve_limit = ret.txn_dp_initial;
+
+    // Pages reclaiming : bulk writes mostly append hence shorter GC scans, at tip reclaim thoroughly
+    ret.rp_augment_limit = bulk ? std::clamp<uint64_t>(physical_memory / page_size / 16, 256_KiB, 32_MiB) : 32_MiB;
+
+    // Spilling : in bulk (rare as commits come first) spill larger chunks less often
+    ret.spill_max_denominator = bulk ? 4 : 8;
+    ret.spill_min_denominator = bulk ? 16 : 8;
+
+    ret.growth_size =
+        bulk ? std::clamp<size_t>(batch_size * 4, 1_GiB, 8_GiB) : std::clamp<size_t>(batch_size, 128_MiB, 2_GiB);
     return ret;
 }
 
+void apply_env_tuning(::mdbx::env& env, const EnvTuning& tuning) {
+    // C++ bindings don't have setoptions
+    ::mdbx::error::success_or_throw(::mdbx_env_set_option(env, MDBX_opt_rp_augment_limit, tuning.rp_augment_limit));
+    if (env.get_flags() & MDBX_RDONLY) return;
+
+    // txn_dp_initial can't exceed txn_dp_limit
+    uint64_t dirty_pages_limit{0};
+    ::mdbx::error::success_or_throw(::mdbx_env_get_option(env, MDBX_opt_txn_dp_limit, &dirty_pages_limit));
+    if (tuning.txn_dp_limit) dirty_pages_limit = tuning.txn_dp_limit;
+    ::mdbx::error::success_or_throw(
+        ::mdbx_env_set_option(env, MDBX_opt_txn_dp_initial, std::min(tuning.txn_dp_initial, dirty_pages_limit)));
+    ::mdbx::error::success_or_throw(::mdbx_env_set_option(env, MDBX_opt_txn_dp_limit, dirty_pages_limit));
+    ::mdbx::error::success_or_throw(::mdbx_env_set_option(env, MDBX_opt_dp_reserve_limit, tuning.dp_reserve_limit));
+    ::mdbx::error::success_or_throw(
+        ::mdbx_env_set_option(env, MDBX_opt_spill_max_denominator, tuning.spill_max_denominator));
+    ::mdbx::error::success_or_throw(
+        ::mdbx_env_set_option(env, MDBX_opt_spill_min_denominator, tuning.spill_min_denominator));
+
+    if (tuning.growth_size) {
+        static constexpr intptr_t kUnchanged{-1};
+        ::mdbx::error::success_or_throw(::mdbx_env_set_geometry(env, kUnchanged, kUnchanged, kUnchanged,
+                                                                static_cast<intptr_t>(tuning.growth_size), kUnchanged,
+                                                                kUnchanged));
+    }
+}
+
+void tune_env(::mdbx::env& env, const EnvConfig& config, SyncPhase phase) {
+    if (config.shared) return;
+    EnvTuning tuning{config.auto_tuning
+                         ? auto_env_tuning(get_physical_memory(), config.batch_size, env.get_pagesize(), phase)
+                         : config.tuning};
+    if (config.inmemory) tuning.growth_size = 0;  // Keep the geometry set on open
+    apply_env_tuning(env, tuning);
+}
+
 ::mdbx::map_handle open_map(::mdbx::txn& tx, const MapConfig& config) {
     if (tx.is_readonly()) {
         return tx.open_map(config.name, config.key_mode, config.value_mode);
@@ -164,8 +425,31 @@ static inline mdbx::cursor::move_operation move_operation(CursorMoveDirection di
     return tx.create_map(config.name, config.key_mode, config.value_mode);
 }
 
+::mdbx::map_handle open_cached_map(::mdbx::txn& tx, const MapConfig& config) {
+    const auto env_id{reinterpret_cast<uintptr_t>(::mdbx_env_get_userctx(tx.env()))};
+    if (!env_id || !config.name) return open_map(tx, config);
+
+    const std::string_view name{config.name};
+    for (const auto& item : cached_map_handles_) {
+        if (item.env_id == env_id && item.name == name) return item.handle;
+    }
+
+    const auto ret{open_map(tx, config)};
+    if (!tx.is_readonly()) {
+        // A handle opened by a write transaction is private to it till commit: should the transaction abort it
+        // would be closed and its slot possibly reused by another map. Only cache handles already shared.
+        unsigned flags{0};
+        unsigned state{0};
+        ::mdbx::error::success_or_throw(::mdbx_dbi_flags_ex(tx, ret.dbi, &flags, &state));
+        if (state & MDBX_DBI_CREAT) return ret;
+    }
+    if (cached_map_handles_.size() == kMaxCachedMapHandles) cached_map_handles_.clear();
+    cached_map_handles_.push_back({env_id, std::string{name}, ret});
+    return ret;
+}
+
 ::mdbx::cursor_managed open_cursor(::mdbx::txn& tx, const MapConfig& config) {
-    return tx.open_cursor(open_map(tx, config));
+    return tx.open_cursor(open_cached_map(tx, config));
 }
 
 size_t max_value_size_for_leaf_page(const size_t page_size, const size_t key_size) {
@@ -231,7 +515,7 @@ void Cursor::bind(::mdbx::txn& txn, const MapConfig& config) {
         close();
         handle_ = ::mdbx_cursor_create(nullptr);
     }
-    const auto map{open_map(txn, config)};
+    const auto map{open_cached_map(txn, config)};
     ::mdbx::cursor::bind(txn, map);
 }
 
@@ -261,6 +545,13 @@ size_t Cursor::size() const { return get_map_stat().ms_entries; }
 
 bool Cursor::empty() const { return size() == 0; }
 
+std::span<uint8_t> Cursor::reserve(const ByteView key, const size_t value_length, const MDBX_put_flags_t flags) {
+    ::mdbx::slice value{};
+    value.iov_len = value_length;  // mdbx sets iov_base to the reserved space
+    ::mdbx::error::success_or_throw(put(to_slice(key), &value, flags | MDBX_RESERVE));
+    return {static_cast<uint8_t*>(value.data()), value.length()};
+}
+
 bool has_map(::mdbx::txn& tx, const char* map_name) {
     try {
         ::mdbx::map_handle main_map{1};
@@ -283,10 +574,18 @@ size_t cursor_for_each(::mdbx::cursor& cursor, WalkFuncRef walker, const CursorM
     return ret;
 }
 
+Bytes prefix_upper_bound(const ByteView prefix) {
+    Bytes ret{prefix};
+    while (!ret.empty() && ret.back() == 0xff) ret.pop_back();
+    if (!ret.empty()) ++ret.back();
+    return ret;
+}
+
 size_t cursor_for_prefix(::mdbx::cursor& cursor, const ByteView prefix, WalkFuncRef walker,
                          CursorMoveDirection direction) {
     size_t ret{0};
-    auto data{cursor.lower_bound(prefix, false)};
+    auto data{direction == CursorMoveDirection::Forward ? cursor.lower_bound(prefix, /*throw_notfound=*/false)
+                                                        : last_with_prefix(cursor, prefix)};
     while (data) {
         if (!data.key.starts_with(prefix)) {
             break;
@@ -299,19 +598,108 @@ size_t cursor_for_prefix(::mdbx::cursor& cursor, const ByteView prefix, WalkFunc
 }
 
 size_t cursor_erase_prefix(::mdbx::cursor& cursor, const ByteView prefix) {
+    // Whole map has the prefix when both first and last keys have it. This, as well as seeking the first key with the
+    // prefix, holds only with usual collation : on other maps keys sharing a prefix are not contiguous
+    auto data{cursor.to_last(/*throw_notfound=*/false)};
+    if (!data) return 0;
+    const bool usual_collation{is_usual_collation(cursor)};
+    if (prefix.empty() || (usual_collation && data.key.starts_with(prefix) &&
+                           cursor.to_first(/*throw_notfound=*/false).key.starts_with(prefix))) {
+        return clear_whole_map(cursor);
+    }
+
+    const bool multi_value{is_multi_value(cursor)};
     size_t ret{0};
-    auto data{cursor.lower_bound(prefix, /*throw_notfound=*/false)};
+    if (!usual_collation) {
+        data = cursor.to_first(/*throw_notfound=*/false);
+        while (data) {
+            if (data.key.starts_with(prefix)) ret += erase_current(cursor, multi_value);
+            data = cursor.to_next(/*throw_notfound=*/false);
+        }
+        return ret;
+    }
+
+    data = cursor.lower_bound(prefix, /*throw_notfound=*/false);
     while (data) {
         if (!data.key.starts_with(prefix)) {
             break;
         }
-        ++ret;
-        cursor.erase();
+        ret += erase_current(cursor, multi_value);
         data = cursor.to_next(/*throw_notfound=*/false);
     }
     return ret;
 }
 
+std::vector<std::optional<ByteView>> cursor_multi_find(::mdbx::cursor& cursor, std::span<const ByteView> keys,
+                                                       bool sorted) {
+    // Max number of records walked to reach the next key before falling back to a seek
+    static constexpr size_t kMaxForwardSteps{8};
+
+    std::vector<std::optional<ByteView>> ret(keys.size());
+    if (!is_usual_collation(cursor)) {
+        // Forward steps rely on byte order : plain seeks otherwise
+        for (size_t i{0}; i < keys.size(); ++i) {
+            const auto data{cursor.find(to_slice(keys[i]), /*throw_notfound=*/false)};
+            if (data) ret[i] = from_slice(data.value);
+        }
+        return ret;
+    }
+
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    if (!sorted) {
+        std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+    }
+
+    // Current position is the smallest key not lower than the previous looked up key
+    bool positioned{false};
+    bool past_end{false};
+    ByteView current_key;
+    ByteView current_value;
+    const auto assign{[&](const ::mdbx::cursor::move_result& data) {
+        positioned = true;
+        past_end = !data;
+        if (data) {
+            current_key = from_slice(data.key);
+            current_value = from_slice(data.value);
+        }
+    }};
+
+    for (const auto index : order) {
+        if (past_end) break;  // No more keys in map : remaining ones are not found
+        const ByteView key{keys[index]};
+        for (size_t steps{0}; positioned && !past_end && current_key < key && steps < kMaxForwardSteps; ++steps) {
+            assign(cursor.to_next_first_multi(/*throw_notfound=*/false));
+        }
+        if (!positioned || (!past_end && current_key < key)) {
+            assign(cursor.lower_bound(key, /*throw_notfound=*/false));
+        }
+        if (!past_end && current_key == key) ret[index] = current_value;
+    }
+    return ret;
+}
+
+// Reads a page of values by means of a MDBX_*_MULTIPLE operation returning an empty view when there are no more
+static ByteView get_multiple(::mdbx::cursor& cursor, ::mdbx::slice& key, MDBX_cursor_op operation) {
+    ::mdbx::slice data{};
+    const auto rc{::mdbx_cursor_get(cursor, &key, &data, operation)};
+    if (rc == MDBX_NOTFOUND) return {};
+    ::mdbx::error::success_or_throw(rc);
+    return from_slice(data);
+}
+
+ByteView cursor_get_multiple(::mdbx::cursor& cursor, const ByteView key) {
+    // MDBX_GET_MULTIPLE reads from current position : position on key first
+    ::mdbx::slice key_slice{to_slice(key)};
+    if (!cursor.find(key_slice, /*throw_notfound=*/false)) return {};
+    return get_multiple(cursor, key_slice, MDBX_GET_MULTIPLE);
+}
+
+ByteView cursor_next_multiple(::mdbx::cursor& cursor) {
+    ::mdbx::slice key{};
+    return get_multiple(cursor, key, MDBX_NEXT_MULTIPLE);
+}
+
 size_t cursor_for_count(::mdbx::cursor& cursor, WalkFuncRef walker, size_t count, const CursorMoveDirection direction) {
     size_t ret{0};
     auto data{adjust_cursor_position_if_unpositioned(cursor, direction)};
@@ -324,15 +712,192 @@ size_t cursor_for_count(::mdbx::cursor& cursor, WalkFuncRef walker, size_t count
     return ret;
 }
 
+bool cursor_append(::mdbx::cursor& cursor, const ByteView key, const ByteView value) {
+    return append_or_upsert(cursor, key, value, append_flags(cursor));
+}
+
+BulkInsertResult cursor_bulk_insert(::mdbx::cursor& cursor, FeedFuncRef feeder) {
+    BulkInsertResult ret{};
+    const auto flags{append_flags(cursor)};
+    ByteView key;
+    ByteView value;
+    while (feeder(key, value)) {
+        if (append_or_upsert(cursor, key, value, flags)) {
+            ++ret.appended;
+        } else {
+            ++ret.upserted;
+        }
+    }
+    return ret;
+}
+
+// Loads the 8 bytes of key following offset as a big endian number (missing bytes are zeroes)
+static inline uint64_t load_interpolation_point(const ByteView key, const size_t offset) {
+    uint8_t buffer[8]{};
+    if (offset < key.length()) {
+        const auto count{std::min(key.length() - offset, sizeof(buffer))};
+        std::memcpy(buffer, &key[offset], count);
+    }
+    return endian::load_big_u64(buffer);
+}
+
+std::vector<KeyRange> split_key_ranges(::mdbx::cursor& cursor, const size_t max_ranges) {
+    std::vector<KeyRange> ret;
+    const auto first{cursor.to_first(/*throw_notfound=*/false)};
+    if (!first) return ret;
+    const Bytes first_key{from_slice(first.key)};
+    const Bytes last_key{from_slice(cursor.to_last(/*throw_notfound=*/false).key)};
+
+    if (max_ranges < 2 || !is_usual_collation(cursor) || first_key == last_key) {
+        ret.emplace_back();
+        return ret;
+    }
+
+    const auto mismatch{std::ranges::mismatch(first_key, last_key)};
+    const auto prefix_length{static_cast<size_t>(std::distance(first_key.begin(), mismatch.in1))};
+    const auto low{load_interpolation_point(first_key, prefix_length)};
+    const auto high{load_interpolation_point(last_key, prefix_length)};
+    const auto step{(high - low) / max_ranges};
+
+    Bytes range_begin{};
+    if (step != 0) {
+        for (size_t i{1}; i < max_ranges; ++i) {
+            Bytes boundary(last_key.substr(0, prefix_length));
+            boundary.resize(prefix_length + sizeof(uint64_t));
+            endian::store_big_u64(&boundary[prefix_length], low + step * i);
+            ret.push_back({std::move(range_begin), boundary});
+            range_begin = std::move(boundary);
+        }
+    }
+    ret.push_back({std::move(range_begin), {}});
+    return ret;
+}
+
+// Walks the records of a key range returning their number
+static size_t scan_key_range(ROTxn& txn, const MapConfig& config, const KeyRange& range, const size_t range_index,
+                             RangeWalkFuncRef walker) {
+    Cursor cursor(*txn, config);
+    auto data{range.begin.empty() ? cursor.to_first(/*throw_notfound=*/false)
+                                  : cursor.lower_bound(to_slice(range.begin), /*throw_notfound=*/false)};
+    size_t ret{0};
+    while (data) {
+        const auto key{from_slice(data.key)};
+        if (!range.end.empty() && key.compare(range.end) >= 0) break;
+        ++ret;
+        walker(range_index, key, from_slice(data.value));
+        data = cursor.to_next(/*throw_notfound=*/false);
+    }
+    return ret;
+}
+
+// Scans the key ranges of a map in parallel provided the transactions of all the ranges read the same snapshot the
+// ranges have been computed on. Returns std::nullopt, without having walked any record, when they don't
+static std::optional<size_t> try_for_each_parallel(ROAccess& access, const MapConfig& config, RangeWalkFuncRef walker,
+                                                   const size_t max_threads) {
+    std::vector<KeyRange> ranges;
+    uint64_t snapshot_id{0};
+    {
+        auto txn{access.start_ro_tx()};
+        if (!has_map(*txn, config.name)) return 0;
+        snapshot_id = txn->id();
+        Cursor cursor(*txn, config);
+        ranges = split_key_ranges(cursor, parallel_scan_threads(max_threads));
+    }
+    if (ranges.empty()) return 0;
+
+    std::vector<std::optional<ROTxn>> txns(ranges.size());
+    std::vector<uint64_t> txn_ids(ranges.size(), 0);
+    std::vector<size_t> counts(ranges.size(), 0);
+    std::vector<std::exception_ptr> exceptions(ranges.size());
+
+    // Walking starts only once the transactions of all ranges are open and have been checked
+    std::latch opened{static_cast<std::ptrdiff_t>(ranges.size())};
+    std::latch checked{1};
+    bool consistent{false};
+
+    const auto open_range{[&](size_t i) {
+        try {
+            txns[i].emplace(access.start_ro_tx());
+            txn_ids[i] = (*txns[i])->id();
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+        opened.count_down();
+    }};
+    const auto scan_range{[&](size_t i) {
+        try {
+            if (consistent) counts[i] = scan_key_range(*txns[i], config, ranges[i], i, walker);
+        } catch (...) {
+            exceptions[i] = std::current_exception();
+        }
+        txns[i].reset();
+    }};
+
+    std::vector<std::thread> threads;
+    threads.reserve(ranges.size());
+    size_t next_range{0};
+    try {
+        for (; next_range < ranges.size(); ++next_range) {
+            threads.emplace_back([&, i = next_range]() {
+                open_range(i);
+                checked.wait();
+                scan_range(i);
+            });
+        }
+    } catch (...) {
+        // Out of threads (e.g. resource limits) : the remaining ranges are scanned by the calling thread
+    }
+    const size_t first_local_range{next_range};
+    for (; next_range < ranges.size(); ++next_range) open_range(next_range);
+
+    opened.wait();
+    consistent = std::ranges::all_of(txn_ids, [snapshot_id](uint64_t id) { return id == snapshot_id; });
+    checked.count_down();
+    for (size_t i{first_local_range}; i < ranges.size(); ++i) scan_range(i);
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& exception : exceptions) {
+        if (exception) std::rethrow_exception(exception);
+    }
+    if (!consistent) return std::nullopt;
+    return std::accumulate(counts.begin(), counts.end(), size_t{0});
+}
+
+size_t cursor_for_each_parallel(ROAccess access, const MapConfig& config, RangeWalkFuncRef walker, size_t max_threads) {
+    // A commit landing while the ranges are being opened spreads them over different snapshots : start over
+    static constexpr size_t kMaxAttempts{16};
+    for (size_t attempt{1};; ++attempt) {
+        if (const auto processed{try_for_each_parallel(access, config, walker, max_threads)}) return *processed;
+        if (attempt == kMaxAttempts) {
+            throw std::runtime_error("Unable to scan " + std::string(config.name) + " on a consistent snapshot");
+        }
+    }
+}
+
 size_t cursor_erase(mdbx::cursor& cursor, const ByteView set_key, const CursorMoveDirection direction) {
+    // Whole map is in range when the first key (forward) or the last key (reverse) is. Keys are compared by the
+    // collation of the map as bytes order doesn't match keys order on e.g. MDBX_INTEGERKEY maps
+    const auto edge{direction == CursorMoveDirection::Forward ? cursor.to_first(/*throw_notfound=*/false)
+                                                              : cursor.to_last(/*throw_notfound=*/false)};
+    if (!edge) return 0;
+    if (set_key.empty()) {
+        // No key is lower than the empty one
+        return direction == CursorMoveDirection::Forward ? clear_whole_map(cursor) : 0;
+    }
+    const auto edge_order{compare_keys(cursor, edge.key, to_slice(set_key))};
+    if (direction == CursorMoveDirection::Forward ? edge_order >= 0 : edge_order < 0) {
+        return clear_whole_map(cursor);
+    }
+
     mdbx::cursor::move_result data{direction == CursorMoveDirection::Forward
                                        ? cursor.lower_bound(set_key, /*throw_notfound=*/false)
                                        : strict_lower_bound(cursor, set_key)};
 
+    // Range bounds are on keys hence all values of multi-value keys are in range
+    const bool multi_value{is_multi_value(cursor)};
     size_t ret{0};
     while (data) {
-        ++ret;
-        cursor.erase();
+        ret += erase_current(cursor, multi_value);
         data = cursor.move(move_operation(direction), /*throw_notfound=*/false);
     }
     return ret;
@@ -14,6 +14,18 @@
 #include <mdbx.h++>
 #pragma GCC diagnostic pop
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <absl/functional/function_ref.h>
 
 #include <zen/core/common/base.hpp>
@@ -38,6 +50,9 @@ namespace detail {
     };
 }  // namespace detail
 
+struct MapConfig;
+class ROTxnPool;
+
 //! \brief This class wraps a read only transaction.
 //! It is used to make clear in the methods signature that the method does not require read-write access.
 //! It can either create a transaction from an environment or manage an externally created one.
@@ -51,21 +66,50 @@ class ROTxn {
 
     //! \brief Move construction
     ROTxn(ROTxn&& source) noexcept
-        : external_txn_(source.external_txn_), managed_txn_(std::move(source.managed_txn_)) {}
+        : external_txn_(source.external_txn_),
+          managed_txn_(std::move(source.managed_txn_)),
+          cursors_(std::move(source.cursors_)),
+          pool_(std::exchange(source.pool_, nullptr)) {}
+
+    //! \brief Transactions withdrawn from a ROTxnPool are parked back, along with their cursors, on destruction
+    ~ROTxn();
 
     mdbx::txn& operator*() { return external_txn_ ? *external_txn_ : managed_txn_; }
     mdbx::txn* operator->() { return external_txn_ ? external_txn_ : &managed_txn_; }
     explicit operator mdbx::txn&() { return external_txn_ ? *external_txn_ : managed_txn_; }
 
+    //! \brief Returns a cursor on the map bound to this transaction. The cursor is opened on first request and
+    //! cached for the lifetime of the transaction: when the transaction is pooled it survives recycling
+    ::mdbx::cursor& cursor(const MapConfig& config);
+
     void abort() {
+        cursors_.clear();
         if (!external_txn_) managed_txn_.abort();
     }
 
   protected:
+    friend class ROTxnPool;
+
+    using CachedCursors = std::deque<std::pair<std::string, ::mdbx::cursor_managed>>;
+
     explicit ROTxn(mdbx::txn_managed&& source) : managed_txn_{std::move(source)} {}
+    ROTxn(mdbx::txn_managed&& source, CachedCursors&& cursors, ROTxnPool* pool)
+        : managed_txn_{std::move(source)}, cursors_{std::move(cursors)}, pool_{pool} {}
 
     mdbx::txn* external_txn_{nullptr};
     mdbx::txn_managed managed_txn_;
+    CachedCursors cursors_;     // Cursors opened by cursor() (must be destroyed before the transaction)
+    ROTxnPool* pool_{nullptr};  // The pool this transaction has been withdrawn from (if any)
+};
+
+//! \brief Metrics of a read-write transaction commit (see mdbx_txn_commit_ex)
+struct CommitStats {
+    uint64_t dirty_bytes{0};                   // Amount of dirty data flushed by the commit
+    std::chrono::microseconds preparation{0};  // Time spent preparing the commit
+    std::chrono::microseconds gc{0};           // Time spent updating the GC (aka freelist)
+    std::chrono::microseconds write{0};        // Time spent writing dirty pages
+    std::chrono::microseconds sync{0};         // Time spent syncing data to disk
+    std::chrono::microseconds whole{0};        // Overall duration of the commit
 };
 
 //! \brief This class wraps read-write transactions, it is used to manages mdbx transactions across stages.
@@ -85,42 +129,107 @@ class RWTxn : public ROTxn {
     RWTxn(const RWTxn&) = delete;
     RWTxn& operator=(const RWTxn&) = delete;
     // Only movable
-    RWTxn(RWTxn&& source) noexcept : ROTxn(std::move(source)) {}
-
-    void commit(const bool renew = true) {
-        /*
-         * renew is required here due to RAII
-         * RWTxn txn(env);
-         * txn.commit();
-         * env.close();
-         * causes a segfault for tx being aborted when the env is already closed
-         *
-         * Workarounds
-         * - either pass renew==false to last commit
-         * - or keep RWTxn in a lower scope
-         * */
-        if (external_txn_ == nullptr) {
-            mdbx::env env = managed_txn_.env();
-            managed_txn_.commit();
-            if (renew) {
-                managed_txn_ = env.start_write();  // renew transaction
-            }
-        }
-    }
+    RWTxn(RWTxn&& source) noexcept
+        : ROTxn(std::move(source)),
+          dirty_budget_{source.dirty_budget_},
+          sub_commits_{source.sub_commits_},
+          last_commit_stats_{source.last_commit_stats_} {}
+
+    //! \brief Enables automatic splitting of the transaction: at each safe point the transaction is committed and
+    //! renewed if its dirty data exceed the budget or the room left for dirty pages (MDBX_opt_txn_dp_limit) runs low,
+    //! which would otherwise lead to MDBX_TXN_FULL or to pages being spilled
+    //! \param [in] max_dirty_bytes : the budget of dirty data (0 disables automatic splitting)
+    //! \remarks Has no effect on external transactions as they're committed by their owner
+    void set_dirty_budget(size_t max_dirty_bytes) noexcept { dirty_budget_ = max_dirty_bytes; }
+
+    //! \brief Returns the budget of dirty data (0 when automatic splitting is disabled)
+    [[nodiscard]] size_t dirty_budget() const noexcept { return dirty_budget_; }
+
+    //! \brief Declares a safe point i.e. a state where data written so far is consistent hence can be committed
+    //! \return Whether the transaction has been committed and renewed
+    //! \remarks After a commit cursors bound to the transaction must be rebound
+    bool safe_point();
+
+    //! \brief Returns the number of commits carried out at safe points
+    [[nodiscard]] size_t sub_commits() const noexcept { return sub_commits_; }
+
+    void commit(const bool renew = true);
+
+    //! \brief Returns the metrics of the last commit
+    [[nodiscard]] const CommitStats& last_commit_stats() const noexcept { return last_commit_stats_; }
+
+  private:
+    size_t dirty_budget_{0};  // Max dirty data before committing at a safe point (0 means never)
+    size_t sub_commits_{0};   // Number of commits carried out at safe points
+    CommitStats last_commit_stats_{};
+};
+
+//! \brief A pool of parked read-only transactions recycled by means of mdbx_txn_reset / mdbx_txn_renew
+//! \remarks A reset transaction releases its snapshot but keeps its slot in the reader table : hence the number of
+//! parked transactions is capped below the environment's max_readers. The pool must outlive the transactions
+//! withdrawn from it and must be destroyed before the env. Thread safe.
+class ROTxnPool {
+  public:
+    //! \brief Creates a pool of parked transactions on the environment
+    //! \param [in] env : the environment to start transactions on
+    //! \param [in] max_parked : max number of parked transactions (0 means a quarter of max_readers). Anyway capped to
+    //! leave at least one reader slot available for non pooled transactions
+    explicit ROTxnPool(const mdbx::env& env, size_t max_parked = 0);
+    ~ROTxnPool();
+
+    // Not copyable nor movable
+    ROTxnPool(const ROTxnPool&) = delete;
+    ROTxnPool& operator=(const ROTxnPool&) = delete;
+
+    //! \brief Returns a ready to use transaction, renewing a parked one if any (hit) or starting a new one (miss)
+    [[nodiscard]] ROTxn acquire();
+
+    //! \brief Number of currently parked transactions
+    [[nodiscard]] size_t size() const;
+
+    //! \brief Max number of parked transactions
+    [[nodiscard]] size_t max_size() const noexcept { return max_parked_; }
+
+    //! \brief Number of acquisitions served by a parked transaction
+    [[nodiscard]] uint64_t hits() const noexcept { return hits_.load(); }
+
+    //! \brief Number of acquisitions which required starting a new transaction
+    [[nodiscard]] uint64_t misses() const noexcept { return misses_.load(); }
+
+  private:
+    friend class ROTxn;
+
+    struct ParkedTxn {
+        mdbx::txn_managed txn;
+        ROTxn::CachedCursors cursors;
+    };
+
+    //! \brief Parks a transaction (and its cursors) or lets it be aborted if the pool is full
+    void release(mdbx::txn_managed&& txn, ROTxn::CachedCursors&& cursors) noexcept;
+
+    mdbx::env env_;
+    const size_t max_parked_;
+    mutable std::mutex mutex_;
+    std::vector<ParkedTxn> parked_;
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
 };
 
 //! \brief This class create ROTxn(s) on demand, it is used to enforce in some method signatures the type of db access
 class ROAccess {
   public:
     explicit ROAccess(mdbx::env& env) : env_{env} {}
+    //! \brief Transactions are withdrawn from the provided pool
+    ROAccess(mdbx::env& env, ROTxnPool& pool) : env_{env}, pool_{&pool} {}
     ROAccess(const ROAccess& copy) = default;
 
-    ROTxn start_ro_tx() { return ROTxn(env_); }
+    ROTxn start_ro_tx() { return pool_ ? pool_->acquire() : ROTxn(env_); }
 
     mdbx::env& operator*() { return env_; }
 
   protected:
     mdbx::env& env_;
+    ROTxnPool* pool_{nullptr};
 };
 
 //! \brief This class create RWTxn(s) on demand, it is used to enforce in some method signatures the type of db access
@@ -136,6 +245,38 @@ class RWAccess : public ROAccess {
 //! \brief Reference to a processing function invoked by cursor_for_each & cursor_for_count on each record
 using WalkFuncRef = absl::FunctionRef<void(ByteView key, ByteView value)>;
 
+//! \brief Reference to a processing function invoked by cursor_for_each_parallel on each record. The first argument is
+//! the index of the key range the record belongs to
+using RangeWalkFuncRef = absl::FunctionRef<void(size_t range_index, ByteView key, ByteView value)>;
+
+//! \brief Reference to a function feeding cursor_bulk_insert with records in sorted order
+//! \remarks Must return false when there are no more records. Provided views must remain valid until next call
+using FeedFuncRef = absl::FunctionRef<bool(ByteView& key, ByteView& value)>;
+
+//! \brief Durability of committed transactions
+enum class DurabilityMode {
+    kDurable,  // Each commit is synced to disk (MDBX_SYNC_DURABLE)
+    kLazy,     // Commits are not synced (MDBX_SAFE_NOSYNC) : syncing is left to a background EnvSyncer
+};
+
+//! \brief Phases of the sync process an environment can be tuned for (see auto_env_tuning)
+enum class SyncPhase {
+    kBulk,  // Initial sync : large write transactions of up to batch_size dirty data, mostly appending
+    kTip,   // Following the tip of the chain : small write transactions, concurrent readers
+};
+
+//! \brief Operational options of an environment (see MDBX_option_t) affecting dirty pages, pages reclaiming and file
+//! growth. Unless otherwise stated values are counts of pages
+struct EnvTuning {
+    uint64_t rp_augment_limit{32_MiB};  // Max pages gathered from GC before growing the data file
+    uint64_t txn_dp_initial{16_KiB};    // Initial room for dirty pages of a write transaction
+    uint64_t dp_reserve_limit{16_KiB};  // Max released pages kept in reserve for next transactions
+    uint64_t txn_dp_limit{0};           // Max dirty pages of a write transaction before spilling (0 = unchanged)
+    uint64_t spill_max_denominator{8};  // At most 1/N of dirty pages are spilled at once (0 = no limit)
+    uint64_t spill_min_denominator{8};  // At least 1/N of dirty pages are spilled at once (0 = no minimum)
+    size_t growth_size{0};              // Increment size (bytes) of each extension of the data file (0 = unchanged)
+};
+
 //! \brief Essential environment settings
 struct EnvConfig {
     std::string path{};
@@ -151,6 +292,12 @@ struct EnvConfig {
     size_t growth_size{2_GiB};  // Increment size for each extension
     uint32_t max_tables{128};   // Default max number of named tables
     uint32_t max_readers{100};  // Default max number of readers
+    DurabilityMode durability{DurabilityMode::kDurable};  // Durability of commits
+    uint32_t sync_period_seconds{10};                     // Max interval amongst syncs in lazy durability
+    size_t sync_threshold{256_MiB};                       // Max unsynced data in lazy durability
+    bool auto_tuning{false};     // Whether operational options are derived from physical memory and batch_size
+    size_t batch_size{512_MiB};  // Dirty data expected per write transaction (auto tuning only)
+    EnvTuning tuning{};          // Operational options (ignored with auto tuning)
 };
 
 //! \brief Configuration settings for a "map" (aka a table)
@@ -166,12 +313,44 @@ struct MapConfig {
 //! \remarks May throw exceptions
 ::mdbx::env_managed open_env(const EnvConfig& config);
 
+//! \brief Derives the operational options of an environment from the amount of physical memory and of the dirty data
+//! expected per write transaction
+//! \param [in] physical_memory : the physical memory of the system in bytes (0 if unknown : defaults are returned)
+//! \param [in] batch_size : the dirty data expected per write transaction (see RWTxn::set_dirty_budget)
+//! \param [in] page_size : the page size of the environment
+//! \param [in] phase : the sync phase to tune for
+//! \remarks In bulk phase the room for dirty pages exceeds batch_size so transactions are committed at safe points
+//! before mdbx has to spill, GC scans are shorter and the data file grows in larger steps. In tip phase less memory
+//! is held by dirty pages (more is left to the OS page cache serving readers) and GC is scanned thoroughly to contain
+//! file growth
+[[nodiscard]] EnvTuning auto_env_tuning(size_t physical_memory, size_t batch_size, size_t page_size, SyncPhase phase);
+
+//! \brief Applies operational options to an opened environment
+//! \remarks Options take effect on next transactions hence this can be invoked at runtime (e.g. in between sync
+//! cycles) but not while the calling thread holds a write transaction. On environments opened read-only only
+//! rp_augment_limit is applied
+void apply_env_tuning(::mdbx::env& env, const EnvTuning& tuning);
+
+//! \brief Applies the operational options configured for an environment : with auto tuning they're derived from
+//! the physical memory of the system and batch_size for the given phase, otherwise the configured ones are applied
+//! \remarks No-op for shared environments (options belong to the process which opened the environment first)
+void tune_env(::mdbx::env& env, const EnvConfig& config, SyncPhase phase = SyncPhase::kBulk);
+
 //! \brief Opens an mdbx "map" (aka table)
 //! \param [in] tx : a reference to a valid mdbx transaction
 //! \param [in] config : the configuration settings for the map
 //! \return A handle to the opened map
 ::mdbx::map_handle open_map(::mdbx::txn& tx, const MapConfig& config);
 
+//! \brief Opens an mdbx "map" (aka table) reusing, if any, the handle already resolved on the same environment
+//! \param [in] tx : a reference to a valid mdbx transaction
+//! \param [in] config : the configuration settings for the map
+//! \return A handle to the opened map
+//! \remarks Handles are cached per thread and per environment (only those opened by open_env) once they are shared
+//! across transactions, i.e. not private to a write transaction which could abort. Cached handles never expire: maps
+//! are not expected to be dropped
+::mdbx::map_handle open_cached_map(::mdbx::txn& tx, const MapConfig& config);
+
 //! \brief Opens a cursor to an mdbx "map" (aka table)
 //! \param [in] tx : a reference to a valid mdbx transaction
 //! \param [in] config : the configuration settings for the underlying map
@@ -231,6 +410,16 @@ class Cursor : public ::mdbx::cursor {
     //! \brief Returns whether the underlying table is empty
     [[nodiscard]] bool empty() const;
 
+    //! \brief Reserves space for a value of the given length under key (MDBX_RESERVE) and returns it for the caller
+    //! to fill in, e.g. by means of a ser::SpanStream. This saves the serialization into an intermediate buffer and
+    //! its copy into the db page
+    //! \param [in] key : The key of the record
+    //! \param [in] value_length : The exact length of the value to be written
+    //! \param [in] flags : Additional put flags (e.g. MDBX_APPEND)
+    //! \remarks The returned span points into a dirty db page hence it must be completely written before any other
+    //! operation on the transaction. Not available on multi-value tables
+    [[nodiscard]] std::span<uint8_t> reserve(ByteView key, size_t value_length, MDBX_put_flags_t flags = MDBX_UPSERT);
+
     //! \brief Exposes handles cache
     static const ObjectPool<MDBX_cursor, detail::cursor_handle_deleter>& handles_cache() { return handles_pool_; }
 
@@ -268,6 +457,11 @@ enum class CursorMoveDirection {
 size_t cursor_for_each(::mdbx::cursor& cursor, WalkFuncRef func,
                        CursorMoveDirection direction = CursorMoveDirection::Forward);
 
+//! \brief Returns the smallest key greater than all keys starting with the provided prefix (i.e. the prefix with
+//! trailing 0xff bytes stripped and its last byte incremented)
+//! \return The upper bound or an empty value when the prefix has none (empty or made of 0xff bytes only)
+Bytes prefix_upper_bound(ByteView prefix);
+
 //! \brief Executes a function on each record reachable by the provided cursor asserting keys start with provided prefix
 //! \param [in] cursor : A reference to a cursor opened on a map
 //! \param [in] prefix : The prefix each key must start with
@@ -275,6 +469,7 @@ size_t cursor_for_each(::mdbx::cursor& cursor, WalkFuncRef func,
 //! function may stop the loop
 //! \param [in] direction : Whether the cursor should navigate records forward (default) or backwards
 //! \return The overall number of processed records
+//! \remarks The cursor is positioned on either the first or the last key with the prefix on behalf of the direction
 size_t cursor_for_prefix(::mdbx::cursor& cursor, ByteView prefix, WalkFuncRef func,
                          CursorMoveDirection direction = CursorMoveDirection::Forward);
 
@@ -297,13 +492,128 @@ size_t cursor_for_count(::mdbx::cursor& cursor, WalkFuncRef func, size_t max_cou
 //! \param [in] direction : Whether the cursor should navigate records forward (default) or backwards.
 //! \return The overall number of erased records
 //! \remarks When direction is forward all keys greater equal set_key will be deleted. When direction is reverse all
-//! keys lower than set_key will be deleted.
+//! keys lower than set_key will be deleted. When the range spans the whole map this is a single clear of the map,
+//! and on multi-value maps all the values of a key are erased at once (MDBX_ALLDUPS)
 size_t cursor_erase(::mdbx::cursor& cursor, ByteView set_key,
                     CursorMoveDirection direction = CursorMoveDirection::Forward);
 
 //! \brief Erases all records whose key starts with a prefix
 //! \param [in] cursor : A reference to a cursor opened on a map
 //! \param [in] prefix : Delete keys starting with this prefix
+//! \return The overall number of erased records
+//! \remarks Same fast paths as cursor_erase : the map is cleared when all its keys have the prefix and all the values
+//! of a key are erased at once on multi-value maps. On MDBX_INTEGERKEY or MDBX_REVERSEKEY maps, where keys sharing a
+//! prefix are not contiguous, the whole map is walked
 size_t cursor_erase_prefix(::mdbx::cursor& cursor, ByteView prefix);
 
+//! \brief Looks up a batch of keys with forward only seeks
+//! \param [in] cursor : A reference to a cursor opened on a map
+//! \param [in] keys : The keys to look up in any order (duplicates allowed)
+//! \param [in] sorted : Whether keys are already sorted in ascending order, which saves sorting them
+//! \return The values found for each key (std::nullopt for keys not found) in the same order as keys
+//! \remarks Keys are resolved in ascending order: each lookup starts from the position of the previous one, stepping
+//! forward when the next key is close and seeking otherwise, hence a batch touches pages mostly sequentially rather
+//! than descending the B-tree at random. Returned values point into db pages (valid until the transaction ends or the
+//! map is modified). On multi-value maps the first value of each key is returned. Keys ordering and stepping assume
+//! usual (byte wise) collation: on MDBX_INTEGERKEY or MDBX_REVERSEKEY maps each key is looked up by its own seek
+std::vector<std::optional<ByteView>> cursor_multi_find(::mdbx::cursor& cursor, std::span<const ByteView> keys,
+                                                       bool sorted = false);
+
+//! \brief Positions the cursor on key and returns the first page of its values packed together (MDBX_GET_MULTIPLE)
+//! \param [in] cursor : A reference to a cursor opened on a multi-value map with fixed size values (MDBX_DUPFIXED)
+//! \param [in] key : The key whose values are to be read
+//! \return The values stored in the first page of the key (contiguous, all of the same length) or an empty view if
+//! the key is not found
+//! \remarks Reading a whole page of values costs one call instead of one per value. The view points into a db page
+//! (valid until the transaction ends or the map is modified). Throws on maps without MDBX_DUPFIXED
+ByteView cursor_get_multiple(::mdbx::cursor& cursor, ByteView key);
+
+//! \brief Returns the next page of values of the key the cursor is positioned on (MDBX_NEXT_MULTIPLE)
+//! \return The values stored in next page (see cursor_get_multiple) or an empty view when all values have been read
+ByteView cursor_next_multiple(::mdbx::cursor& cursor);
+
+//! \brief Outcome of a bulk insert
+struct BulkInsertResult {
+    size_t appended{0};  // Records written in append mode
+    size_t upserted{0};  // Records found out of order hence written by regular upsert
+};
+
+//! \brief Writes a record with append semantics (MDBX_APPEND or MDBX_APPEND|MDBX_APPENDDUP for multi-value maps)
+//! \param [in] cursor : A reference to a cursor opened on a map (requires RW transaction)
+//! \param [in] key : The key of the record
+//! \param [in] value : The value of the record
+//! \return True if the record has been appended, False if it was out of order and has been upserted instead
+//! \remarks Appending skips the B-tree search and fills pages completely: it's meant for rebuilding tables from
+//! scratch out of data sorted in key order
+bool cursor_append(::mdbx::cursor& cursor, ByteView key, ByteView value);
+
+//! \brief Writes a stream of records, expected in key (and value) order, with append semantics
+//! \param [in] cursor : A reference to a cursor opened on a map (requires RW transaction)
+//! \param [in] feeder : A reference to a function returning records in sorted order
+//! \return The number of records appended and the number of those which, being out of order, have been upserted
+BulkInsertResult cursor_bulk_insert(::mdbx::cursor& cursor, FeedFuncRef feeder);
+
+//! \brief A [begin, end) interval of keys. An empty begin (end) stands for the beginning (end) of the table
+struct KeyRange {
+    Bytes begin{};
+    Bytes end{};
+};
+
+//! \brief Splits the key space of a map into contiguous ranges
+//! \param [in] cursor : A reference to a cursor opened on a map
+//! \param [in] max_ranges : The max number of ranges to split the key space into
+//! \return The ordered ranges covering the whole key space. Empty if the map holds no records
+//! \remarks Boundaries are obtained interpolating the 8 bytes following the prefix shared by the first and the last
+//! key: this gives a balanced split for evenly distributed keys (hashes, big endian numbers). Maps with other than
+//! usual key collation are never split
+std::vector<KeyRange> split_key_ranges(::mdbx::cursor& cursor, size_t max_ranges);
+
+//! \brief Executes a function on each record of a map scanning disjoint key ranges on separate threads
+//! \param [in] access : The access to the environment. Each thread works in its own read-only transaction
+//! \param [in] config : The configuration settings of the map
+//! \param [in] walker : A reference to a function with the code to execute on records. It's invoked concurrently by
+//! different threads: the range index can be used to address per-range state without any locking
+//! \param [in] max_threads : The max number of ranges hence threads (0 means hardware concurrency)
+//! \return The overall number of processed records
+//! \remarks Relies on MDBX_NOTLS (see open_env) and requires a free reader slot per thread. All ranges are walked on
+//! the same snapshot: records are walked only once the transactions of all ranges are found on the snapshot the
+//! ranges have been split on, otherwise (a write has been committed meanwhile) the scan starts over and gives up with
+//! std::runtime_error after a few attempts. When no more threads can be created the remaining ranges are walked by
+//! the calling thread. The first exception thrown by any thread is rethrown after all threads have completed
+size_t cursor_for_each_parallel(ROAccess access, const MapConfig& config, RangeWalkFuncRef walker,
+                                size_t max_threads = 0);
+
+//! \brief Resolves the number of threads used by cursor_for_each_parallel
+inline size_t parallel_scan_threads(size_t max_threads) {
+    return max_threads ? max_threads : std::max(1U, std::thread::hardware_concurrency());
+}
+
+//! \brief Folds all the records of a map by means of cursor_for_each_parallel
+//! \param [in] access : The access to the environment
+//! \param [in] config : The configuration settings of the map
+//! \param [in] init : The initial (identity) value of each per-range accumulator
+//! \param [in] map_func : A function (T& accumulator, ByteView key, ByteView value) folding a record into the
+//! accumulator of the range it belongs to
+//! \param [in] reduce_func : A function (T lhs, T rhs) -> T combining the accumulators of two ranges
+//! \param [in] max_threads : The max number of ranges hence threads (0 means hardware concurrency)
+//! \return The combination of the accumulators of all ranges
+template <typename T, typename MapFunc, typename ReduceFunc>
+T cursor_reduce_parallel(ROAccess access, const MapConfig& config, const T& init, MapFunc&& map_func,
+                         ReduceFunc&& reduce_func, size_t max_threads = 0) {
+    max_threads = parallel_scan_threads(max_threads);
+    std::vector<T> accumulators(max_threads, init);
+    (void)cursor_for_each_parallel(
+        access, config,
+        [&accumulators, &map_func](size_t range_index, ByteView key, ByteView value) {
+            map_func(accumulators[range_index], key, value);
+        },
+        max_threads);
+
+    T result{std::move(accumulators.front())};
+    for (auto it{std::next(accumulators.begin())}; it != accumulators.end(); ++it) {
+        result = reduce_func(std::move(result), std::move(*it));
+    }
+    return result;
+}
+
 }  // namespace zen::db
@@ -0,0 +1,183 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <zen/core/common/endian.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+static const MapConfig kBenchMapConfig{"BenchTable"};
+
+// Runs the provided map resolution on a write transaction over an already existing map
+template <typename OpenFunc>
+static void bench_map_resolution(benchmark::State& state, OpenFunc&& open_func) {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    {
+        RWTxn txn{env};
+        (void)open_map(*txn, kBenchMapConfig);
+        txn.commit(/*renew=*/false);
+    }
+
+    auto txn{env.start_write()};
+    int items_processed{0};
+    for ([[maybe_unused]] auto _ : state) {
+        open_func(txn);
+        ++items_processed;
+    }
+    state.SetItemsProcessed(items_processed);
+}
+
+void bench_open_map(benchmark::State& state) {
+    bench_map_resolution(state, [](::mdbx::txn& txn) { benchmark::DoNotOptimize(open_map(txn, kBenchMapConfig).dbi); });
+}
+
+void bench_open_cached_map(benchmark::State& state) {
+    bench_map_resolution(state,
+                         [](::mdbx::txn& txn) { benchmark::DoNotOptimize(open_cached_map(txn, kBenchMapConfig).dbi); });
+}
+
+void bench_cursor_construction(benchmark::State& state) {
+    bench_map_resolution(state, [](::mdbx::txn& txn) {
+        Cursor cursor(txn, kBenchMapConfig);
+        benchmark::DoNotOptimize(cursor.map().dbi);
+    });
+}
+
+// Looks up batches of random keys (the batch size is given as argument) out of a map of 1M records
+template <typename LookupFunc>
+static void bench_batch_lookup(benchmark::State& state, LookupFunc&& lookup_func) {
+    static constexpr uint64_t kRecords{1'000'000};
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    auto env{open_env(db_config)};
+    {
+        RWTxn txn{env};
+        Cursor cursor(txn, kBenchMapConfig);
+        const Bytes value(64, 0xaa);
+        Bytes key(sizeof(uint64_t), 0);
+        for (uint64_t i{0}; i < kRecords; ++i) {
+            endian::store_big_u64(key.data(), i);
+            cursor_append(cursor, key, value);
+        }
+        txn.commit(/*renew=*/false);
+    }
+
+    const auto batch_size{static_cast<size_t>(state.range(0))};
+    std::vector<Bytes> keys(batch_size, Bytes(sizeof(uint64_t), 0));
+    std::vector<ByteView> key_views(keys.begin(), keys.end());
+    std::mt19937_64 rng{0};
+
+    auto txn{env.start_read()};
+    Cursor cursor(txn, kBenchMapConfig);
+    for ([[maybe_unused]] auto _ : state) {
+        state.PauseTiming();
+        for (auto& key : keys) endian::store_big_u64(key.data(), rng() % (kRecords * 2));  // ~50% misses
+        state.ResumeTiming();
+        lookup_func(cursor, key_views);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch_size));
+}
+
+void bench_single_find(benchmark::State& state) {
+    bench_batch_lookup(state, [](Cursor& cursor, const std::vector<ByteView>& keys) {
+        for (const auto key : keys) benchmark::DoNotOptimize(cursor.find(to_slice(key), /*throw_notfound=*/false));
+    });
+}
+
+void bench_multi_find(benchmark::State& state) {
+    bench_batch_lookup(state, [](Cursor& cursor, const std::vector<ByteView>& keys) {
+        benchmark::DoNotOptimize(cursor_multi_find(cursor, keys));
+    });
+}
+
+// Erases records out of a map of 100K keys (with the number of values per key given as argument) in a transaction
+// which is aborted after each iteration
+template <typename EraseFunc>
+static void bench_erase(benchmark::State& state, EraseFunc&& erase_func) {
+    static constexpr uint64_t kKeys{100'000};
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+
+    const auto values_per_key{static_cast<uint64_t>(state.range(0))};
+    const MapConfig map_config{kBenchMapConfig.name, mdbx::key_mode::usual,
+                               values_per_key > 1 ? mdbx::value_mode::multi : mdbx::value_mode::single};
+    {
+        RWTxn txn{env};
+        Cursor cursor(txn, map_config);
+        Bytes key(sizeof(uint64_t), 0);
+        Bytes value(sizeof(uint64_t), 0);
+        for (uint64_t i{0}; i < kKeys; ++i) {
+            endian::store_big_u64(key.data(), i);
+            for (uint64_t j{0}; j < values_per_key; ++j) {
+                endian::store_big_u64(value.data(), j);
+                cursor_append(cursor, key, value);
+            }
+        }
+        txn.commit(/*renew=*/false);
+    }
+
+    int64_t items_processed{0};
+    for ([[maybe_unused]] auto _ : state) {
+        auto txn{env.start_write()};
+        Cursor cursor(txn, map_config);
+        items_processed += static_cast<int64_t>(erase_func(cursor, kKeys));
+        state.PauseTiming();
+        cursor.close();
+        txn.abort();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(items_processed);
+}
+
+void bench_erase_whole_map(benchmark::State& state) {
+    bench_erase(state, [](Cursor& cursor, uint64_t) { return cursor_erase(cursor, {}); });
+}
+
+void bench_erase_half_map(benchmark::State& state) {
+    bench_erase(state, [](Cursor& cursor, uint64_t keys) {
+        Bytes set_key(sizeof(uint64_t), 0);
+        endian::store_big_u64(set_key.data(), keys / 2);
+        return cursor_erase(cursor, set_key, CursorMoveDirection::Forward);
+    });
+}
+
+// Baseline : erases half of the map one record at a time
+void bench_erase_half_map_by_record(benchmark::State& state) {
+    bench_erase(state, [](Cursor& cursor, uint64_t keys) {
+        Bytes set_key(sizeof(uint64_t), 0);
+        endian::store_big_u64(set_key.data(), keys / 2);
+        size_t ret{0};
+        for (auto data{cursor.lower_bound(to_slice(set_key), /*throw_notfound=*/false)}; data;
+             data = cursor.to_next(/*throw_notfound=*/false)) {
+            std::ignore = cursor.erase();
+            ++ret;
+        }
+        return ret;
+    });
+}
+
+BENCHMARK(bench_open_map);
+BENCHMARK(bench_open_cached_map);
+BENCHMARK(bench_cursor_construction);
+BENCHMARK(bench_single_find)->Arg(64)->Arg(1'024)->Arg(16'384);
+BENCHMARK(bench_multi_find)->Arg(64)->Arg(1'024)->Arg(16'384);
+BENCHMARK(bench_erase_whole_map)->Arg(1)->Arg(16);
+BENCHMARK(bench_erase_half_map)->Arg(1)->Arg(16);
+BENCHMARK(bench_erase_half_map_by_record)->Arg(1)->Arg(16);
+
+}  // namespace zen::db
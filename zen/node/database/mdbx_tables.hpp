@@ -30,9 +30,10 @@ inline constexpr db::MapConfig kConfig{"Config"};
 //! \details Stores Block headers information
 //! \struct
 //! \verbatim
-//!   key   : TODO
-//!   value : TODO
+//!   key   : block_num_u32 (BE)
+//!   value : serialized header
 //! \endverbatim
+//! \remarks Headers deep enough below the tip are moved into segment files (see freeze_headers)
 inline constexpr db::MapConfig kHeaders{"Headers"};
 
 inline constexpr const char* kDbSchemaVersionKey{"DbSchemaVersion"};
@@ -5,14 +5,21 @@
    file COPYING or http://www.opensource.org/licenses/mit-license.php.
 */
 
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstring>
 #include <map>
 #include <thread>
+#include <tuple>
 #include <vector>
 
 #include <catch2/catch.hpp>
 
 #include <zen/core/common/cast.hpp>
+#include <zen/core/common/endian.hpp>
+#include <zen/core/serialization/serialize.hpp>
+#include <zen/core/serialization/span_stream.hpp>
 
 #include <zen/node/common/directories.hpp>
 #include <zen/node/database/mdbx.hpp>
@@ -63,6 +70,69 @@ TEST_CASE("Database Environment", "[database]") {
     }
 }
 
+static uint64_t get_env_option(::mdbx::env& env, MDBX_option_t option) {
+    uint64_t ret{0};
+    ::mdbx::error::success_or_throw(::mdbx_env_get_option(env, option, &ret));
+    return ret;
+}
+
+TEST_CASE("Environment tuning", "[database]") {
+    const TempDirectory tmp_dir{};
+
+    SECTION("Auto profile") {
+        const auto bulk{auto_env_tuning(64_GiB, 512_MiB, 4_KiB, SyncPhase::kBulk)};
+        const auto tip{auto_env_tuning(64_GiB, 512_MiB, 4_KiB, SyncPhase::kTip)};
+        CHECK(bulk.txn_dp_limit * 4_KiB > 512_MiB);  // Room beyond the batch
+        CHECK(tip.txn_dp_limit == bulk.txn_dp_limit);
+        CHECK(tip.txn_dp_initial < bulk.txn_dp_initial);
+        CHECK(bulk.txn_dp_initial <= bulk.txn_dp_limit);
+        CHECK(bulk.growth_size > tip.growth_size);
+
+        // Dirty pages are capped by physical memory
+        const auto small{auto_env_tuning(1_GiB, 512_MiB, 4_KiB, SyncPhase::kBulk)};
+        CHECK(small.txn_dp_limit * 4_KiB == 256_MiB);
+        CHECK(auto_env_tuning(1_GiB, 512_MiB, 4_KiB, SyncPhase::kTip).txn_dp_limit * 4_KiB == 128_MiB);
+
+        // Bigger pages fewer of them
+        CHECK(auto_env_tuning(64_GiB, 512_MiB, 16_KiB, SyncPhase::kBulk).txn_dp_limit == bulk.txn_dp_limit / 4);
+
+        // Unknown physical memory
+        CHECK(auto_env_tuning(0, 512_MiB, 4_KiB, SyncPhase::kBulk).txn_dp_limit == 0);
+    }
+
+    SECTION("Configured options") {
+        EnvConfig db_config{tmp_dir.path().string(), /*create=*/true};
+        db_config.tuning.txn_dp_limit = 32_KiB;
+        db_config.tuning.txn_dp_initial = 2_KiB;
+        db_config.tuning.dp_reserve_limit = 4_KiB;
+        db_config.tuning.rp_augment_limit = 1_MiB;
+        auto env{open_env(db_config)};
+        CHECK(get_env_option(env, MDBX_opt_txn_dp_limit) == 32_KiB);
+        CHECK(get_env_option(env, MDBX_opt_txn_dp_initial) == 2_KiB);
+        CHECK(get_env_option(env, MDBX_opt_dp_reserve_limit) == 4_KiB);
+        CHECK(get_env_option(env, MDBX_opt_rp_augment_limit) == 1_MiB);
+    }
+
+    SECTION("Auto tuning at runtime") {
+        EnvConfig db_config{tmp_dir.path().string(), /*create=*/true};
+        db_config.auto_tuning = true;
+        db_config.batch_size = 64_MiB;
+        auto env{open_env(db_config)};
+        const auto bulk_initial{get_env_option(env, MDBX_opt_txn_dp_initial)};
+        CHECK(get_env_option(env, MDBX_opt_txn_dp_limit) * db_config.page_size >= db_config.batch_size);
+
+        tune_env(env, db_config, SyncPhase::kTip);
+        CHECK(get_env_option(env, MDBX_opt_txn_dp_initial) <= bulk_initial);
+        CHECK(env.get_info().mi_geo.grow == 128_MiB);
+
+        // Transactions still work with the new options
+        RWTxn txn{env};
+        Cursor cursor(txn, {"Tuned"});
+        cursor.upsert(to_slice(string_view_to_byte_view("key")), to_slice(string_view_to_byte_view("value")));
+        REQUIRE_NOTHROW(txn.commit(/*renew=*/false));
+    }
+}
+
 TEST_CASE("Database Cursor", "[database]") {
     const TempDirectory tmp_dir;
     db::EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
@@ -172,6 +242,32 @@ TEST_CASE("Read/Write Transaction", "[database]") {
         }
     }
 
+    SECTION("Auto split") {
+        auto tx{db::RWTxn(env)};
+        CHECK_FALSE(tx.safe_point());  // Disabled
+        tx.set_dirty_budget(64_KiB);
+
+        const Bytes value(1_KiB, 0xab);
+        Bytes key(sizeof(uint64_t), 0);
+        db::Cursor table_cursor(tx, {table_name});
+        for (uint64_t i{0}; i < 1'000; ++i) {
+            endian::store_big_u64(key.data(), i);
+            table_cursor.upsert(to_slice(key), to_slice(value));
+            if (tx.safe_point()) table_cursor.bind(tx, {table_name});
+        }
+        CHECK(tx.sub_commits() >= 1'000 * value.size() / 64_KiB / 2);
+        tx.commit(/*renew=*/true);
+        table_cursor.bind(tx, {table_name});
+        CHECK(table_cursor.size() == 1'000);
+
+        // External transactions are never split
+        auto ext_tx{env.start_write()};
+        auto rw_tx{db::RWTxn(ext_tx)};
+        rw_tx.set_dirty_budget(1);
+        CHECK_FALSE(rw_tx.safe_point());
+        CHECK(rw_tx.sub_commits() == 0);
+    }
+
     SECTION("Cursor from RWTxn") {
         auto tx{db::RWTxn(env)};
         db::Cursor table_cursor(tx, {table_name});
@@ -384,6 +480,471 @@ TEST_CASE("Database Cursor Walk", "[database]") {
         data_map.clear();
         cursor_for_each(table_cursor, save_all_data_map);
         REQUIRE(data_map.rbegin()->second == "Valine");
+
+        // Whole map in range
+        const auto entries{table_cursor.size()};
+        set_key.assign({'A'});
+        CHECK(cursor_erase(table_cursor, set_key, CursorMoveDirection::Forward) == entries);
+        CHECK(table_cursor.empty());
+        CHECK(cursor_erase(table_cursor, {}) == 0);
+    }
+
+    SECTION("Erase multi-value") {
+        Cursor multi_cursor(txn, {"MultiValue", mdbx::key_mode::usual, mdbx::value_mode::multi});
+        const auto populate{[&multi_cursor]() {
+            for (const auto& [key, value] : kGeneticCodes) {
+                // Amino acid -> codons
+                multi_cursor.upsert(mdbx::slice{value}, mdbx::slice{key});
+            }
+        }};
+        populate();
+        const auto entries{multi_cursor.size()};
+        REQUIRE(entries == kGeneticCodes.size());
+
+        // All codons of amino acids before "L"
+        const auto count_before{static_cast<size_t>(std::count_if(kGeneticCodes.begin(), kGeneticCodes.end(),
+                                                                  [](const auto& item) { return item.second < "L"; }))};
+        CHECK(cursor_erase(multi_cursor, string_view_to_byte_view("L"), CursorMoveDirection::Reverse) == count_before);
+        CHECK(multi_cursor.size() == entries - count_before);
+        CHECK_FALSE(multi_cursor.find(mdbx::slice{"Glycine"}, /*throw_notfound=*/false));
+        CHECK(multi_cursor.find(mdbx::slice{"Leucine"}, /*throw_notfound=*/false));
+
+        // All codons of amino acids from "S"
+        const auto count_after{static_cast<size_t>(std::count_if(kGeneticCodes.begin(), kGeneticCodes.end(),
+                                                                 [](const auto& item) { return item.second >= "S"; }))};
+        CHECK(cursor_erase(multi_cursor, string_view_to_byte_view("S")) == count_after);
+        CHECK(multi_cursor.size() == entries - count_before - count_after);
+
+        // Prefix
+        CHECK(cursor_erase_prefix(multi_cursor, string_view_to_byte_view("Leu")) == 6);
+        CHECK_FALSE(multi_cursor.find(mdbx::slice{"Leucine"}, /*throw_notfound=*/false));
+
+        // Whole map
+        multi_cursor.txn().clear_map(multi_cursor.map());
+        populate();
+        CHECK(cursor_erase_prefix(multi_cursor, {}) == entries);
+        CHECK(multi_cursor.empty());
+    }
+
+    SECTION("Erase on integer keys") {
+        // Native endian integers : bytes order differs from keys order (e.g. 1 is 0x01 0x00... while 256 is
+        // 0x00 0x01...) hence byte wise comparisons of first or last key would wrongly clear the whole map
+        Cursor integer_cursor(txn, {"IntegerKeys", mdbx::key_mode::ordinal});
+        const auto key_of{[](uint64_t number) {
+            Bytes key(sizeof(uint64_t), '\0');
+            std::memcpy(key.data(), &number, sizeof(number));
+            return key;
+        }};
+        const auto populate{[&]() {
+            for (const uint64_t number : {1U, 2U, 256U, 257U}) {
+                integer_cursor.upsert(to_slice(key_of(number)), to_slice(key_of(number)));
+            }
+        }};
+        const auto has_key{[&](uint64_t number) {
+            return static_cast<bool>(integer_cursor.find(to_slice(key_of(number)), /*throw_notfound=*/false));
+        }};
+
+        populate();
+        CHECK(cursor_erase(integer_cursor, key_of(256), CursorMoveDirection::Forward) == 2);
+        CHECK(integer_cursor.size() == 2);
+        CHECK((has_key(1) && has_key(2)));
+
+        integer_cursor.txn().clear_map(integer_cursor.map());
+        populate();
+        CHECK(cursor_erase(integer_cursor, key_of(2), CursorMoveDirection::Reverse) == 1);
+        CHECK(integer_cursor.size() == 3);
+        CHECK_FALSE(has_key(1));
+
+        // Keys starting with byte 0x01 (1 and 257) are not contiguous
+        integer_cursor.txn().clear_map(integer_cursor.map());
+        populate();
+        const Bytes prefix{0x01};
+        CHECK(cursor_erase_prefix(integer_cursor, prefix) == 2);
+        CHECK(integer_cursor.size() == 2);
+        CHECK((has_key(2) && has_key(256)));
+    }
+}
+
+TEST_CASE("Map handles cache", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    const MapConfig config_a{"TableA"};
+    const MapConfig config_b{"TableB"};
+
+    // Handle of a map created by an aborted transaction is closed: must not be cached
+    {
+        auto txn{env.start_write()};
+        (void)open_cached_map(txn, config_a);
+        txn.abort();
+    }
+    ::mdbx::map_handle handle_b;
+    {
+        auto txn{env.start_write()};
+        handle_b = open_cached_map(txn, config_b);
+        txn.commit();
+    }
+
+    auto txn{env.start_write()};
+    CHECK_FALSE(has_map(txn, config_a.name));
+    CHECK(open_cached_map(txn, config_b).dbi == handle_b.dbi);
+    CHECK(open_cached_map(txn, config_a).dbi != handle_b.dbi);
+    Cursor cursor(txn, config_b);
+    CHECK(cursor.map().dbi == handle_b.dbi);
+    txn.commit();
+
+    // Same map names on another environment
+    const TempDirectory other_tmp_dir;
+    EnvConfig other_db_config{other_tmp_dir.path().string(), /*create*/ true};
+    other_db_config.inmemory = true;
+    auto other_env{db::open_env(other_db_config)};
+    auto other_txn{other_env.start_write()};
+    (void)open_cached_map(other_txn, {"TableC"});
+    CHECK(open_cached_map(other_txn, config_b).dbi == open_map(other_txn, config_b).dbi);
+}
+
+TEST_CASE("Read transactions pool", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    db_config.max_readers = 16;
+    auto env{db::open_env(db_config)};
+    const MapConfig map_config{"GeneticCode"};
+    {
+        RWTxn txn{env};
+        Cursor cursor(txn, map_config);
+        for (const auto& [key, value] : kGeneticCodes) {
+            cursor.upsert(to_slice(key), to_slice(value));
+        }
+        txn.commit(/*renew=*/false);
+    }
+
+    SECTION("Capped by max readers") {
+        // Note mdbx may round max_readers up
+        CHECK(ROTxnPool(env).max_size() == env.max_readers() / 4);
+        CHECK(ROTxnPool(env, 10'000).max_size() == env.max_readers() - 1);
+    }
+
+    SECTION("Reuse") {
+        ROTxnPool pool(env, 2);
+        ROAccess access(env, pool);
+        const MDBX_txn* handle{nullptr};
+        {
+            auto txn{access.start_ro_tx()};
+            handle = *txn;
+            CHECK(txn.cursor(map_config).find("AAA").value.as_string() == "Lysine");
+        }
+        CHECK(pool.misses() == 1);
+        CHECK(pool.hits() == 0);
+        CHECK(pool.size() == 1);
+        {
+            auto txn{access.start_ro_tx()};
+            CHECK(static_cast<const MDBX_txn*>(*txn) == handle);
+            CHECK(pool.size() == 0);
+            // Cursor survives recycling and is bound to the renewed transaction
+            CHECK(txn.cursor(map_config).find("UUU").value.as_string() == "Phenylalanine");
+        }
+        CHECK(pool.hits() == 1);
+        CHECK(pool.size() == 1);
+    }
+
+    SECTION("Renewed transactions see new data") {
+        ROTxnPool pool(env, 2);
+        { auto txn{pool.acquire()}; }
+        {
+            RWTxn txn{env};
+            Cursor cursor(txn, map_config);
+            cursor.upsert(to_slice(std::string_view{"ZZZ"}), to_slice(std::string_view{"Unknown"}));
+            txn.commit(/*renew=*/false);
+        }
+        auto txn{pool.acquire()};
+        CHECK(pool.hits() == 1);
+        CHECK(txn.cursor(map_config).find("ZZZ", /*throw_notfound=*/false).done);
+    }
+
+    SECTION("Overflow") {
+        ROTxnPool pool(env, 2);
+        {
+            std::vector<ROTxn> txns;
+            for (int i{0}; i < 3; ++i) txns.push_back(pool.acquire());
+            CHECK(pool.misses() == 3);
+        }
+        CHECK(pool.size() == 2);
+    }
+}
+
+TEST_CASE("Bulk insert", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    auto txn{env.start_write()};
+
+    std::vector<std::pair<std::string, std::string>> records(kGeneticCodes.begin(), kGeneticCodes.end());
+    size_t index{0};
+    const auto feeder{[&records, &index](ByteView& key, ByteView& value) -> bool {
+        if (index == records.size()) return false;
+        key = string_view_to_byte_view(records[index].first);
+        value = string_view_to_byte_view(records[index].second);
+        ++index;
+        return true;
+    }};
+
+    std::map<std::string, std::string, std::less<>> data_map;
+    auto save_all_data_map{[&data_map](ByteView key, ByteView value) {
+        data_map.emplace(byte_view_to_string_view(key), byte_view_to_string_view(value));
+    }};
+
+    SECTION("Sorted records") {
+        Cursor table_cursor(txn, {"GeneticCode"});
+        const auto result{cursor_bulk_insert(table_cursor, feeder)};
+        CHECK(result.appended == kGeneticCodes.size());
+        CHECK(result.upserted == 0);
+
+        table_cursor.to_first();
+        cursor_for_each(table_cursor, save_all_data_map);
+        CHECK(data_map == kGeneticCodes);
+    }
+
+    SECTION("Records out of order") {
+        Cursor table_cursor(txn, {"GeneticCode"});
+        std::swap(records[10], records[11]);
+        records.emplace_back("AAA", "Lysine");  // Same key as the first record
+        const auto result{cursor_bulk_insert(table_cursor, feeder)};
+        CHECK(result.upserted == 2);
+        CHECK(result.appended == records.size() - 2);
+
+        table_cursor.to_first();
+        cursor_for_each(table_cursor, save_all_data_map);
+        CHECK(data_map == kGeneticCodes);
+
+        // Appending a key lower than the last one falls back to upsert
+        CHECK_FALSE(cursor_append(table_cursor, string_view_to_byte_view("AAA"), string_view_to_byte_view("Stop")));
+        CHECK(cursor_append(table_cursor, string_view_to_byte_view("ZZZ"), string_view_to_byte_view("Stop")));
+        CHECK(table_cursor.size() == kGeneticCodes.size() + 1);
+        CHECK(table_cursor.find("AAA").value.as_string() == "Stop");
+    }
+
+    SECTION("Multi value") {
+        Cursor table_cursor(txn, {"Amminoacids", mdbx::key_mode::usual, mdbx::value_mode::multi});
+        std::ranges::sort(records, [](const auto& lhs, const auto& rhs) {
+            return std::tie(lhs.second, lhs.first) < std::tie(rhs.second, rhs.first);
+        });
+        for (auto& [code, amminoacid] : records) std::swap(code, amminoacid);
+        records.emplace_back("Alanine", "GCA");  // Already present and out of order
+        const auto result{cursor_bulk_insert(table_cursor, feeder)};
+        CHECK(result.upserted == 1);
+        CHECK(result.appended == kGeneticCodes.size());
+        CHECK(table_cursor.size() == kGeneticCodes.size());
+        CHECK(table_cursor.find_multivalue("Alanine", "GCA", /*throw_notfound=*/false).done);
+    }
+}
+
+TEST_CASE("Parallel scan", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    const MapConfig map_config{"Numbers"};
+
+    SECTION("Missing or empty table") {
+        CHECK(cursor_for_each_parallel(ROAccess{env}, map_config, [](size_t, ByteView, ByteView) {}) == 0);
+        auto txn{env.start_write()};
+        Cursor cursor(txn, map_config);
+        CHECK(split_key_ranges(cursor, 4).empty());
+    }
+
+    // Populate table with big endian numbers
+    constexpr uint64_t kRecords{10'000};
+    {
+        RWTxn txn{env};
+        Cursor cursor(txn, map_config);
+        Bytes key(sizeof(uint64_t), '\0');
+        for (uint64_t i{0}; i < kRecords; ++i) {
+            endian::store_big_u64(key.data(), i * 7);
+            cursor_append(cursor, key, key);
+        }
+        txn.commit(/*renew=*/false);
+    }
+
+    SECTION("Split key ranges") {
+        auto txn{env.start_read()};
+        Cursor cursor(txn, map_config);
+        CHECK(split_key_ranges(cursor, 1).size() == 1);
+
+        const auto ranges{split_key_ranges(cursor, 4)};
+        REQUIRE(ranges.size() == 4);
+        CHECK(ranges.front().begin.empty());
+        CHECK(ranges.back().end.empty());
+        for (size_t i{1}; i < ranges.size(); ++i) {
+            CHECK(ranges[i].begin == ranges[i - 1].end);
+            CHECK(ranges[i - 1].begin < ranges[i - 1].end);
+        }
+    }
+
+    SECTION("For each") {
+        std::vector<std::atomic<uint64_t>> counts(4);
+        std::atomic<uint64_t> sum{0};
+        const auto processed{cursor_for_each_parallel(
+            ROAccess{env}, map_config,
+            [&](size_t range_index, ByteView key, ByteView) {
+                ++counts[range_index];
+                sum += endian::load_big_u64(key.data());
+            },
+            /*max_threads=*/4)};
+        CHECK(processed == kRecords);
+        CHECK(sum.load() == 7 * (kRecords * (kRecords - 1) / 2));
+        for (const auto& count : counts) {
+            CHECK(count.load() == kRecords / 4);
+        }
+    }
+
+    SECTION("Reduce") {
+        const auto max_key{cursor_reduce_parallel(
+            ROAccess{env}, map_config, uint64_t{0},
+            [](uint64_t& acc, ByteView key, ByteView) { acc = std::max(acc, endian::load_big_u64(key.data())); },
+            [](uint64_t lhs, uint64_t rhs) { return std::max(lhs, rhs); }, /*max_threads=*/3)};
+        CHECK(max_key == 7 * (kRecords - 1));
+    }
+
+    SECTION("Exceptions are propagated") {
+        CHECK_THROWS_AS(cursor_for_each_parallel(
+                            ROAccess{env}, map_config,
+                            [](size_t range_index, ByteView, ByteView) {
+                                if (range_index == 1) throw std::runtime_error("failure");
+                            },
+                            /*max_threads=*/2),
+                        std::runtime_error);
+    }
+
+    SECTION("Consistent snapshot") {
+        // Records are added in batches of kBatch per commit : a scan spread over snapshots would likely miss some
+        constexpr uint64_t kBatch{1'000};
+        std::thread writer([&]() {
+            for (uint64_t batch{0}; batch < 20; ++batch) {
+                RWTxn txn{env};
+                Cursor cursor(txn, map_config);
+                Bytes key(sizeof(uint64_t), '\0');
+                for (uint64_t i{0}; i < kBatch; ++i) {
+                    endian::store_big_u64(key.data(), 7 * kRecords + (batch * kBatch + i) * 7);
+                    cursor_append(cursor, key, key);
+                }
+                txn.commit(/*renew=*/false);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+        for (int run{0}; run < 10; ++run) {
+            const auto processed{cursor_for_each_parallel(
+                ROAccess{env}, map_config, [](size_t, ByteView, ByteView) {}, /*max_threads=*/4)};
+            CHECK((processed - kRecords) % kBatch == 0);
+        }
+        writer.join();
+    }
+}
+
+TEST_CASE("Reserve value space", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    auto txn{env.start_write()};
+
+    SECTION("Serialize into page") {
+        Cursor cursor(txn, {"Reserved"});
+        const Bytes key{0x01};
+        auto space{cursor.reserve(key, sizeof(uint64_t) + 3)};
+        REQUIRE(space.size() == sizeof(uint64_t) + 3);
+
+        ser::SpanStream stream(space);
+        ser::write_data(stream, uint64_t{0x0102030405060708});
+        ser::write_compact(stream, 0xfffa);
+        CHECK(stream.full());
+
+        const auto data{cursor.find(to_slice(key))};
+        CHECK(from_slice(data.value) == Bytes{0x08, 0x07, 0x06, 0x05, 0x04, 0x03, 0x02, 0x01, 0xfd, 0xfa, 0xff});
+    }
+
+    SECTION("Append") {
+        Cursor cursor(txn, {"Reserved"});
+        for (uint8_t i{0}; i < 10; ++i) {
+            auto space{cursor.reserve(Bytes{i}, 2, MDBX_APPEND)};
+            space[0] = i;
+            space[1] = static_cast<uint8_t>(i * 2);
+        }
+        CHECK(cursor.size() == 10);
+        CHECK(from_slice(cursor.to_last().value) == Bytes{9, 18});
+        CHECK_THROWS(cursor.reserve(Bytes{0}, 2, MDBX_APPEND));  // Out of order
+    }
+
+    SECTION("Multi-value tables") {
+        Cursor cursor(txn, {"ReservedMulti", mdbx::key_mode::usual, mdbx::value_mode::multi});
+        CHECK_THROWS(cursor.reserve(Bytes{0}, 2));
+    }
+}
+
+TEST_CASE("Multi find", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    RWTxn txn{env};
+
+    Cursor cursor(txn, {"GeneticCode"});
+    for (const auto& [key, value] : kGeneticCodes) {
+        cursor.upsert(mdbx::slice{key}, mdbx::slice{value});
+    }
+
+    // Unsorted, with duplicates, misses in between, before and after all keys
+    std::vector<std::string_view> lookups{"UGG", "AAA", "ZZZ", "CAB", "GCC", "AAA", "A", "UUU", "CAC", "ACA"};
+    std::vector<ByteView> keys;
+    for (const auto key : lookups) keys.push_back(string_view_to_byte_view(key));
+
+    const auto check_results{[&](const std::vector<std::optional<ByteView>>& values) {
+        REQUIRE(values.size() == keys.size());
+        for (size_t i{0}; i < keys.size(); ++i) {
+            const auto it{kGeneticCodes.find(lookups[i])};
+            if (it == kGeneticCodes.end()) {
+                CHECK_FALSE(values[i].has_value());
+            } else {
+                REQUIRE(values[i].has_value());
+                CHECK(byte_view_to_string_view(*values[i]) == it->second);
+            }
+        }
+    }};
+
+    SECTION("Unsorted keys") {
+        cursor.to_last();  // Position must not matter
+        check_results(cursor_multi_find(cursor, keys));
+    }
+
+    SECTION("Sorted keys") {
+        std::sort(keys.begin(), keys.end());
+        std::sort(lookups.begin(), lookups.end());
+        check_results(cursor_multi_find(cursor, keys, /*sorted=*/true));
+    }
+
+    SECTION("Whole map") {
+        std::vector<ByteView> all_keys;
+        for (const auto& [key, _] : kGeneticCodes) all_keys.push_back(string_view_to_byte_view(key));
+        std::reverse(all_keys.begin(), all_keys.end());
+        const auto values{cursor_multi_find(cursor, all_keys)};
+        CHECK(std::all_of(values.begin(), values.end(), [](const auto& value) { return value.has_value(); }));
+        CHECK(byte_view_to_string_view(*values.front()) == "Phenylalanine");  // UUU
+    }
+
+    SECTION("Reverse key map") {
+        Cursor reverse(txn, {"ReverseGeneticCode", mdbx::key_mode::reverse});
+        for (const auto& [key, value] : kGeneticCodes) {
+            reverse.upsert(mdbx::slice{key}, mdbx::slice{value});
+        }
+        check_results(cursor_multi_find(reverse, keys));
+    }
+
+    SECTION("Empty") {
+        CHECK(cursor_multi_find(cursor, {}).empty());
+        Cursor empty(txn, {"Empty"});
+        CHECK_FALSE(cursor_multi_find(empty, keys)[0].has_value());
     }
 }
 
@@ -0,0 +1,80 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "query_env.hpp"
+
+#include <algorithm>
+#include <thread>
+
+#include <zen/core/common/assert.hpp>
+
+#include <zen/node/common/log.hpp>
+
+namespace zen::db {
+
+uint64_t get_latest_txn_id(const ::mdbx::env& env) {
+    // Reads the meta pages : neither a transaction nor a reader slot is required
+    return env.get_info().mi_recent_txnid;
+}
+
+static EnvConfig query_env_config(const QueryEnvConfig& config) {
+    EnvConfig ret{config.path};
+    ret.readonly = true;
+    ret.shared = true;  // Accede to the settings of the writer
+    return ret;
+}
+
+QueryEnv::QueryEnv(const QueryEnvConfig& config)
+    : managed_env_{open_env(query_env_config(config))},
+      env_{*managed_env_},
+      poll_interval_{config.poll_interval},
+      pool_{env_, config.max_parked} {}
+
+QueryEnv::QueryEnv(::mdbx::env env, const QueryEnvConfig& config)
+    : env_{env}, poll_interval_{config.poll_interval}, pool_{env_, config.max_parked} {
+    ZEN_ASSERT(env_);
+}
+
+uint64_t QueryEnv::latest_txn_id() const { return get_latest_txn_id(env_); }
+
+uint64_t QueryEnv::wait_for_change(uint64_t known_txn_id, std::chrono::milliseconds timeout) const {
+    const auto deadline{std::chrono::steady_clock::now() + timeout};
+    while (true) {
+        const auto txn_id{latest_txn_id()};
+        const auto now{std::chrono::steady_clock::now()};
+        if (txn_id > known_txn_id || now >= deadline) return txn_id;
+        std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(poll_interval_, deadline - now));
+    }
+}
+
+ReaderSlots QueryEnv::reader_slots() const {
+    const auto info{env_.get_info()};
+    return {info.mi_numreaders, info.mi_maxreaders};
+}
+
+EnvChangeMonitor::EnvChangeMonitor(boost::asio::io_context& asio_context, ::mdbx::env env,
+                                   uint32_t interval_milliseconds, Handler handler)
+    : env_{env},
+      handler_{std::move(handler)},
+      last_txn_id_{get_latest_txn_id(env_)},
+      timer_{asio_context, interval_milliseconds, [this]() {
+                 try {
+                     std::ignore = check();
+                 } catch (const std::exception& ex) {
+                     std::ignore = log::Error("Unable to check db changes", {"exception", ex.what()});
+                 }
+                 return true;
+             }} {}
+
+bool EnvChangeMonitor::check() {
+    const auto txn_id{get_latest_txn_id(env_)};
+    if (txn_id <= last_txn_id_.load()) return false;
+    last_txn_id_.store(txn_id);
+    if (handler_) handler_(txn_id);
+    return true;
+}
+
+}  // namespace zen::db
@@ -0,0 +1,119 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+#include <boost/asio/io_context.hpp>
+
+#include <zen/node/common/asio_timer.hpp>
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+//! \brief Settings of a query environment
+struct QueryEnvConfig {
+    std::string path{};                            // Path of the environment (as opened by the writer)
+    size_t max_parked{0};                          // Max parked read transactions (0 = see ROTxnPool)
+    std::chrono::milliseconds poll_interval{100};  // Interval amongst checks for new data in wait_for_change
+};
+
+//! \brief Usage of the reader slots of an environment (shared by all processes)
+struct ReaderSlots {
+    uint32_t used{0};  // Slots in use (including those of parked transactions)
+    uint32_t max{0};   // Max number of slots (as set by the process which created the environment)
+};
+
+//! \brief A read-only access to an environment opened, and written, by another process (e.g. the syncing node)
+//! \details Meant for separate query, RPC or export processes so heavy reads don't compete with the syncing process
+//! for its threads and caches. The environment is opened read-only accepting the settings of the writer (page size,
+//! geometry, max readers ...). Reads go through ROAccess over a pool of parked transactions : each read transaction
+//! takes a snapshot of the latest committed data. New data is detected polling the id of the last committed
+//! transaction, which requires no transaction nor reader slot.
+//! \remarks Reader slots are shared with the writer process : parked transactions hold one each, hence max_parked
+//! should be kept low. Long lived read transactions prevent the writer from reclaiming pages (see ReaderWatchdog) :
+//! queries should acquire a transaction per request. The writer must not open the environment in exclusive mode
+class QueryEnv {
+  public:
+    //! \brief Opens an existing environment in read-only shared mode
+    //! \throws std::runtime_error if the environment does not exist
+    explicit QueryEnv(const QueryEnvConfig& config);
+
+    //! \brief Attaches to an environment already opened by this process
+    QueryEnv(::mdbx::env env, const QueryEnvConfig& config);
+
+    // Not copyable nor movable (accesses refer to the pool)
+    QueryEnv(const QueryEnv&) = delete;
+    QueryEnv& operator=(const QueryEnv&) = delete;
+
+    //! \brief Returns an access withdrawing transactions from the pool
+    [[nodiscard]] ROAccess access() noexcept { return {env_, pool_}; }
+
+    [[nodiscard]] ::mdbx::env& env() noexcept { return env_; }
+
+    //! \brief Returns the id of the last committed transaction
+    [[nodiscard]] uint64_t latest_txn_id() const;
+
+    //! \brief Waits until a transaction newer than known_txn_id is committed or timeout expires
+    //! \return The id of the last committed transaction
+    uint64_t wait_for_change(uint64_t known_txn_id, std::chrono::milliseconds timeout) const;
+
+    //! \brief Returns the usage of reader slots
+    [[nodiscard]] ReaderSlots reader_slots() const;
+
+    //! \brief Clears the reader slots of dead processes
+    //! \return The number of cleared slots
+    unsigned check_readers() { return env_.check_readers(); }
+
+  private:
+    std::optional<::mdbx::env_managed> managed_env_;  // When opened by this instance
+    ::mdbx::env env_;
+    const std::chrono::milliseconds poll_interval_;
+    ROTxnPool pool_;
+};
+
+//! \brief Periodically polls an environment for committed transactions notifying the id of the last one
+class EnvChangeMonitor {
+  public:
+    using Handler = std::function<void(uint64_t txn_id)>;
+
+    //! \param [in] asio_context : the asio context driving the timer
+    //! \param [in] env : the environment to monitor
+    //! \param [in] interval_milliseconds : the polling interval
+    //! \param [in] handler : invoked on the asio context thread when new transactions have been committed
+    EnvChangeMonitor(boost::asio::io_context& asio_context, ::mdbx::env env, uint32_t interval_milliseconds,
+                     Handler handler);
+
+    // Not copyable nor movable
+    EnvChangeMonitor(const EnvChangeMonitor&) = delete;
+    EnvChangeMonitor& operator=(const EnvChangeMonitor&) = delete;
+
+    void start() { timer_.start(); }
+    void stop() { timer_.stop(); }
+
+    //! \brief Checks for committed transactions invoking the handler if any
+    //! \return Whether new transactions have been committed since last check
+    bool check();
+
+    //! \brief Id of the last committed transaction as of last check
+    [[nodiscard]] uint64_t last_txn_id() const noexcept { return last_txn_id_.load(); }
+
+  private:
+    ::mdbx::env env_;
+    Handler handler_;
+    std::atomic_uint64_t last_txn_id_{0};
+    Timer timer_;
+};
+
+//! \brief Returns the id of the last committed transaction of an environment without starting a transaction
+[[nodiscard]] uint64_t get_latest_txn_id(const ::mdbx::env& env);
+
+}  // namespace zen::db
@@ -0,0 +1,105 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <stdexcept>
+#include <thread>
+
+#include <boost/asio/io_context.hpp>
+#include <catch2/catch.hpp>
+
+#include <zen/core/common/endian.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/query_env.hpp>
+
+namespace zen::db {
+
+static const MapConfig kQueried{"Queried"};
+
+static void commit_record(::mdbx::env& env, uint64_t value) {
+    RWTxn txn{env};
+    Cursor cursor(txn, kQueried);
+    Bytes key(sizeof(uint64_t), 0);
+    endian::store_big_u64(key.data(), value);
+    cursor.upsert(to_slice(key), to_slice(key));
+    txn.commit(/*renew=*/false);
+}
+
+static size_t count_records(ROAccess access) {
+    auto txn{access.start_ro_tx()};
+    return Cursor(*txn, kQueried).get_map_stat().ms_entries;
+}
+
+TEST_CASE("Query environment", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{open_env(db_config)};
+    commit_record(env, 0);
+
+    QueryEnv query_env(env, {.max_parked = 2, .poll_interval = std::chrono::milliseconds(5)});
+    CHECK(count_records(query_env.access()) == 1);
+    const auto reader_slots{query_env.reader_slots()};
+    CHECK(reader_slots.used >= 1);  // The parked transaction
+    CHECK(reader_slots.max >= db_config.max_readers);
+
+    SECTION("New data") {
+        const auto txn_id{query_env.latest_txn_id()};
+        commit_record(env, 1);
+        CHECK(query_env.latest_txn_id() > txn_id);
+        // Parked transactions are renewed on the latest snapshot
+        CHECK(count_records(query_env.access()) == 2);
+    }
+
+    SECTION("Wait for change") {
+        const auto txn_id{query_env.latest_txn_id()};
+        CHECK(query_env.wait_for_change(txn_id, std::chrono::milliseconds(20)) == txn_id);
+
+        std::thread writer([&env]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            commit_record(env, 1);
+        });
+        CHECK(query_env.wait_for_change(txn_id, std::chrono::seconds(10)) > txn_id);
+        writer.join();
+    }
+
+    SECTION("Change monitor") {
+        boost::asio::io_context context;
+        uint64_t notified{0};
+        EnvChangeMonitor monitor(context, env, 10, [&notified](uint64_t txn_id) { notified = txn_id; });
+        CHECK(monitor.last_txn_id() == query_env.latest_txn_id());
+        CHECK_FALSE(monitor.check());
+        CHECK(notified == 0);
+
+        commit_record(env, 1);
+        CHECK(monitor.check());
+        CHECK(notified == query_env.latest_txn_id());
+        CHECK(monitor.last_txn_id() == notified);
+        CHECK_FALSE(monitor.check());
+    }
+}
+
+TEST_CASE("Query environment open", "[database]") {
+    const TempDirectory tmp_dir;
+    const auto path{(tmp_dir.path() / "chaindata").string()};
+
+    // Must exist
+    CHECK_THROWS_AS(QueryEnv(QueryEnvConfig{.path = path}), std::runtime_error);
+
+    {
+        EnvConfig db_config{path, /*create*/ true};
+        auto env{open_env(db_config)};
+        commit_record(env, 0);
+        commit_record(env, 1);
+    }
+
+    QueryEnv query_env(QueryEnvConfig{.path = path});
+    CHECK(query_env.env().get_flags() & MDBX_RDONLY);
+    CHECK(count_records(query_env.access()) == 2);
+    CHECK(query_env.latest_txn_id() > 0);
+}
+
+}  // namespace zen::db
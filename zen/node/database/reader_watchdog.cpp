@@ -0,0 +1,223 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "reader_watchdog.hpp"
+
+#if defined(_WIN32) || defined(_WIN64)
+// clang-format off
+#include <windows.h>  // Keep the order
+#include <process.h>
+// clang-format on
+#else
+#include <signal.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <zen/core/common/misc.hpp>
+
+#include <zen/node/common/log.hpp>
+
+namespace zen::db {
+
+// Watchdogs by environment : HSR callbacks only get the environment
+static std::mutex watchdogs_mutex;
+static std::map<const MDBX_env*, ReaderWatchdog*> watchdogs;
+
+static mdbx_pid_t current_pid() {
+#if defined(_WIN32) || defined(_WIN64)
+    return static_cast<mdbx_pid_t>(::_getpid());
+#else
+    return ::getpid();
+#endif
+}
+
+//! \brief Whether a process is known to be gone (false when in doubt)
+static bool is_process_dead(mdbx_pid_t pid) {
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE process{::OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid))};
+    if (process == nullptr) return ::GetLastError() == ERROR_INVALID_PARAMETER;
+    DWORD exit_code{0};
+    const bool exited{::GetExitCodeProcess(process, &exit_code) != 0 && exit_code != STILL_ACTIVE};
+    ::CloseHandle(process);
+    return exited;
+#else
+    return ::kill(pid, 0) != 0 && errno == ESRCH;
+#endif
+}
+
+static std::vector<std::string> to_log_args(const ReaderInfo& reader) {
+    return {"slot",     std::to_string(reader.slot),
+            "pid",      std::to_string(reader.pid),
+            "txn",      std::to_string(reader.txn_id),
+            "lag",      std::to_string(reader.lag),
+            "age",      std::to_string(std::chrono::duration_cast<std::chrono::seconds>(reader.age).count()) + "s",
+            "retained", to_human_bytes(reader.bytes_retained)};
+}
+
+ReaderWatchdog::ReaderWatchdog(boost::asio::io_context& asio_context, ::mdbx::env env,
+                               const ReaderWatchdogConfig& config)
+    : env_{env},
+      config_{config},
+      timer_{asio_context, config.interval_seconds * 1'000U, [this]() -> bool {
+                 try {
+                     std::ignore = check();
+                 } catch (const std::exception& ex) {
+                     std::ignore = log::Error("Unable to check db readers", {"exception", ex.what()});
+                 }
+                 return true;
+             }} {
+    std::scoped_lock lock{watchdogs_mutex};
+    if (!watchdogs.emplace(env_, this).second) {
+        throw std::logic_error("A reader watchdog is already attached to this environment");
+    }
+    ::mdbx::error::success_or_throw(::mdbx_env_set_hsr(env_, &ReaderWatchdog::handle_slow_readers));
+}
+
+ReaderWatchdog::~ReaderWatchdog() {
+    timer_.stop();
+    std::scoped_lock lock{watchdogs_mutex};
+    std::ignore = ::mdbx_env_set_hsr(env_, nullptr);
+    watchdogs.erase(env_);
+}
+
+void ReaderWatchdog::set_restart_handler(RestartHandler handler) {
+    std::scoped_lock lock{mutex_};
+    restart_handler_ = std::move(handler);
+}
+
+std::vector<ReaderInfo> ReaderWatchdog::readers() {
+    std::vector<ReaderInfo> ret;
+    ret.reserve(env_.max_readers());  // Collecting must not throw
+    const auto rc{::mdbx_reader_list(
+        env_,
+        [](void* ctx, int, int slot, mdbx_pid_t pid, mdbx_tid_t thread, uint64_t txnid, uint64_t lag, size_t,
+           size_t bytes_retained) noexcept -> int {
+            auto* readers{static_cast<std::vector<ReaderInfo>*>(ctx)};
+            // Skip idle slots (e.g. reset transactions) and never grow the vector
+            if (!txnid || readers->size() == readers->capacity()) return MDBX_SUCCESS;
+            readers->push_back({.slot = slot,
+                                .pid = pid,
+                                .thread = thread,
+                                .txn_id = txnid,
+                                .lag = lag,
+                                .bytes_retained = bytes_retained});
+            return MDBX_SUCCESS;
+        },
+        &ret)};
+    if (rc != MDBX_SUCCESS && rc != MDBX_RESULT_TRUE /* empty table */) ::mdbx::error::success_or_throw(rc);
+
+    // Track the time each slot has been seen on its snapshot
+    const auto now{std::chrono::steady_clock::now()};
+    std::map<int, std::pair<uint64_t, std::chrono::steady_clock::time_point>> seen;
+    std::scoped_lock lock{mutex_};
+    for (auto& reader : ret) {
+        auto it{first_seen_.find(reader.slot)};
+        const auto since{it != first_seen_.end() && it->second.first == reader.txn_id ? it->second.second : now};
+        seen.emplace(reader.slot, std::make_pair(reader.txn_id, since));
+        reader.age = now - since;
+    }
+    first_seen_.swap(seen);
+    return ret;
+}
+
+std::optional<ReaderInfo> ReaderWatchdog::oldest_reader() {
+    const auto list{readers()};
+    const auto it{std::ranges::min_element(list, {}, &ReaderInfo::txn_id)};
+    if (it == list.end()) return std::nullopt;
+    return *it;
+}
+
+std::vector<ReaderInfo> ReaderWatchdog::check() {
+    std::ignore = env_.check_readers();  // Clears slots of dead processes
+
+    const auto list{readers()};
+    if (const auto it{std::ranges::min_element(list, {}, &ReaderInfo::txn_id)}; it != list.end()) {
+        std::ignore = log::Info("Oldest db reader", to_log_args(*it));
+    }
+
+    std::vector<ReaderInfo> ret;
+    for (const auto& reader : list) {
+        if (!is_laggard(reader)) continue;
+        ret.push_back(reader);
+        std::ignore = log::Warning("Laggard db reader", to_log_args(reader));
+        if (config_.policy == ReaderLagPolicy::kRestart) std::ignore = request_restart(reader);
+    }
+    return ret;
+}
+
+bool ReaderWatchdog::is_laggard(const ReaderInfo& reader) const noexcept {
+    return (config_.max_lag && reader.lag > config_.max_lag) ||
+           (config_.max_age.count() && reader.age > config_.max_age);
+}
+
+bool ReaderWatchdog::request_restart(const ReaderInfo& reader) {
+    if (reader.pid != current_pid()) return false;  // Not ours
+    RestartHandler handler;
+    {
+        std::scoped_lock lock{mutex_};
+        handler = restart_handler_;
+    }
+    if (!handler) return false;
+    handler(reader);
+    ++actions_count_;
+    return true;
+}
+
+int ReaderWatchdog::handle_slow_readers(const MDBX_env* env, const MDBX_txn*, mdbx_pid_t pid, mdbx_tid_t tid,
+                                        uint64_t laggard, unsigned gap, size_t space, int retry) noexcept {
+    // Lock held for the whole call : the watchdog can't be destroyed meanwhile
+    std::scoped_lock lock{watchdogs_mutex};
+    const auto it{watchdogs.find(env)};
+    if (it == watchdogs.end()) return -1;
+    try {
+        return it->second->on_slow_reader(pid, tid, laggard, gap, space, retry);
+    } catch (...) {
+        return -1;
+    }
+}
+
+int ReaderWatchdog::on_slow_reader(mdbx_pid_t pid, mdbx_tid_t tid, uint64_t laggard, unsigned gap, size_t space,
+                                   int retry) {
+    // Return codes (see MDBX_hsr_func) : -1 have mdbx grow the data file, 0 rescan the readers table and retry,
+    // 1 the reader's transaction has been aborted hence its slot must be cleared.
+    // This runs on the writing thread holding the write lock : never wait here
+    ReaderInfo reader{.pid = pid, .thread = tid, .txn_id = laggard, .lag = gap, .bytes_retained = space};
+    {
+        std::scoped_lock lock{mutex_};
+        for (const auto& [slot, seen] : first_seen_) {
+            if (seen.first != laggard) continue;
+            reader.slot = slot;
+            reader.age = std::chrono::steady_clock::now() - seen.second;
+            break;
+        }
+    }
+    if (retry == 0) std::ignore = log::Warning("Db reader prevents pages reclaim", to_log_args(reader));
+
+    // Nobody reads the snapshot of a dead process : its slot can be released
+    if (pid != current_pid() && is_process_dead(pid)) {
+        ++actions_count_;
+        std::ignore = log::Warning("Releasing db reader of dead process", to_log_args(reader));
+        return 1;
+    }
+    if (!is_laggard(reader)) return -1;
+
+    switch (config_.policy) {
+        case ReaderLagPolicy::kRestart:
+            // The handler only signals the owner : the restart happens asynchronously and the timer re-evaluates
+            if (retry == 0) std::ignore = request_restart(reader);
+            return -1;
+        case ReaderLagPolicy::kLog:
+            break;
+    }
+    return -1;
+}
+
+}  // namespace zen::db
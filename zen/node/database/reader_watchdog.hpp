@@ -0,0 +1,113 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include <zen/node/common/asio_timer.hpp>
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+//! \brief What to do with readers lagging beyond the configured thresholds
+//! \remarks Live readers are never evicted : releasing the slot of a reader still at work would let the pages of its
+//! snapshot be reused under it. Hence a live laggard can only be asked to restart, and only when it belongs to this
+//! process. Slots of dead processes are released regardless of the policy
+enum class ReaderLagPolicy {
+    kLog,      // Only log them
+    kRestart,  // Ask the owning component to restart its read transaction (asynchronously)
+};
+
+struct ReaderWatchdogConfig {
+    uint32_t interval_seconds{30};                          // Interval between checks
+    uint64_t max_lag{0};                                    // Max transactions a reader may lag behind (0 = no limit)
+    std::chrono::seconds max_age{std::chrono::minutes(5)};  // Max age of a reader (0 = no limit)
+    ReaderLagPolicy policy{ReaderLagPolicy::kLog};
+};
+
+//! \brief A reader slot in use as reported by mdbx_reader_list
+struct ReaderInfo {
+    int slot{0};                                 // Slot number in the readers table
+    mdbx_pid_t pid{0};                           // Process owning the reader
+    mdbx_tid_t thread{};                         // Thread owning the reader
+    uint64_t txn_id{0};                          // Id of the snapshot being read
+    uint64_t lag{0};                             // Number of transactions committed since the snapshot
+    size_t bytes_retained{0};                    // Space the snapshot prevents from being reclaimed
+    std::chrono::steady_clock::duration age{0};  // Time since the reader was first seen on this snapshot
+};
+
+//! \brief Periodically inspects the readers table of an environment reporting readers which lag behind and applying
+//! the configured policy to them. Also clears the slots of dead processes (check_readers) at each check.
+//! \details Long lived read transactions prevent mdbx from reclaiming the pages of the snapshot they read, hence the
+//! data file grows. The watchdog also installs itself as the environment's Handle-Slow-Readers callback (see
+//! mdbx_env_set_hsr) which mdbx invokes when it can't reclaim pages because of the oldest reader : there the slot of a
+//! dead process is released at once while the policy is applied to a live laggard.
+//! \remarks Ages are measured from the first time a reader is seen by a check on its snapshot, hence with a precision
+//! of the checks interval. Only one watchdog per environment is allowed
+class ReaderWatchdog {
+  public:
+    //! \brief Handler asking the owner of a reader to restart its read transaction
+    //! \remarks Invoked from either the asio context thread or a writing thread (HSR callback) : must not block
+    using RestartHandler = std::function<void(const ReaderInfo& reader)>;
+
+    ReaderWatchdog(boost::asio::io_context& asio_context, ::mdbx::env env, const ReaderWatchdogConfig& config);
+    ~ReaderWatchdog();
+
+    // Not copyable nor movable
+    ReaderWatchdog(const ReaderWatchdog&) = delete;
+    ReaderWatchdog& operator=(const ReaderWatchdog&) = delete;
+
+    void start() { timer_.start(); }
+    void stop() { timer_.stop(); }
+
+    //! \brief Sets the handler to invoke for laggard readers of this process with ReaderLagPolicy::kRestart
+    void set_restart_handler(RestartHandler handler);
+
+    //! \brief Returns the readers currently holding a snapshot (idle slots excluded)
+    [[nodiscard]] std::vector<ReaderInfo> readers();
+
+    //! \brief Returns the reader holding the oldest snapshot (if any)
+    [[nodiscard]] std::optional<ReaderInfo> oldest_reader();
+
+    //! \brief Carries out a check : clears stale slots, logs the oldest reader and applies the policy to laggards
+    //! \return The readers lagging beyond the configured thresholds
+    std::vector<ReaderInfo> check();
+
+    //! \brief Number of restarts requested plus slots of dead processes released by the HSR callback
+    [[nodiscard]] uint64_t actions_count() const noexcept { return actions_count_.load(); }
+
+  private:
+    [[nodiscard]] bool is_laggard(const ReaderInfo& reader) const noexcept;
+
+    //! \brief Asks the owner of a reader of this process to restart (false if not applicable)
+    bool request_restart(const ReaderInfo& reader);
+
+    //! \brief Handle-Slow-Readers callback
+    static int handle_slow_readers(const MDBX_env* env, const MDBX_txn* txn, mdbx_pid_t pid, mdbx_tid_t tid,
+                                   uint64_t laggard, unsigned gap, size_t space, int retry) noexcept;
+
+    int on_slow_reader(mdbx_pid_t pid, mdbx_tid_t tid, uint64_t laggard, unsigned gap, size_t space, int retry);
+
+    ::mdbx::env env_;
+    const ReaderWatchdogConfig config_;
+    Timer timer_;
+
+    std::mutex mutex_;
+    std::map<int, std::pair<uint64_t, std::chrono::steady_clock::time_point>> first_seen_;  // Slot -> txn id, time
+    RestartHandler restart_handler_;
+    std::atomic_uint64_t actions_count_{0};
+};
+
+}  // namespace zen::db
@@ -0,0 +1,148 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <stdexcept>
+
+#include <boost/asio/io_context.hpp>
+#include <catch2/catch.hpp>
+
+#include <zen/core/common/endian.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/reader_watchdog.hpp>
+
+namespace zen::db {
+
+static void commit_records(::mdbx::env& env, uint64_t count) {
+    for (uint64_t i{0}; i < count; ++i) {
+        RWTxn txn{env};
+        Cursor cursor(txn, {"Watched"});
+        Bytes key(sizeof(uint64_t), 0);
+        endian::store_big_u64(key.data(), i);
+        cursor.upsert(to_slice(key), to_slice(key));
+        txn.commit(/*renew=*/false);
+    }
+}
+
+TEST_CASE("Reader watchdog", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    auto env{db::open_env(db_config)};
+    boost::asio::io_context asio_context;
+
+    commit_records(env, 1);
+    auto reader_txn{env.start_read()};
+    commit_records(env, 5);
+
+    SECTION("Readers listing") {
+        ReaderWatchdog watchdog(asio_context, env, {});
+        const auto readers{watchdog.readers()};
+        REQUIRE(readers.size() == 1);
+        CHECK(readers[0].txn_id == reader_txn.id());
+        CHECK(readers[0].lag == 5);
+
+        auto second_txn{env.start_read()};
+        const auto oldest{watchdog.oldest_reader()};
+        REQUIRE(oldest.has_value());
+        CHECK(oldest->txn_id == reader_txn.id());
+        CHECK(watchdog.readers().size() == 2);
+
+        second_txn.abort();
+        reader_txn.abort();
+        CHECK(watchdog.readers().empty());
+        CHECK_FALSE(watchdog.oldest_reader().has_value());
+    }
+
+    SECTION("Log policy") {
+        ReaderWatchdogConfig config{.max_lag = 2};
+        ReaderWatchdog watchdog(asio_context, env, config);
+        size_t restarts{0};
+        watchdog.set_restart_handler([&restarts](const ReaderInfo&) { ++restarts; });
+        const auto laggards{watchdog.check()};
+        REQUIRE(laggards.size() == 1);
+        CHECK(laggards[0].txn_id == reader_txn.id());
+        CHECK(restarts == 0);
+        CHECK(watchdog.actions_count() == 0);
+    }
+
+    SECTION("Restart policy") {
+        ReaderWatchdogConfig config{.max_lag = 2, .policy = ReaderLagPolicy::kRestart};
+        ReaderWatchdog watchdog(asio_context, env, config);
+        uint64_t restarted_txn_id{0};
+        watchdog.set_restart_handler(
+            [&restarted_txn_id](const ReaderInfo& reader) { restarted_txn_id = reader.txn_id; });
+        CHECK(watchdog.check().size() == 1);
+        CHECK(restarted_txn_id == reader_txn.id());
+        CHECK(watchdog.actions_count() == 1);
+
+        // Once renewed the reader is no longer a laggard
+        reader_txn.reset_reading();
+        reader_txn.renew_reading();
+        CHECK(watchdog.check().empty());
+        CHECK(watchdog.actions_count() == 1);
+    }
+
+    SECTION("Within thresholds") {
+        ReaderWatchdogConfig config{.max_lag = 10, .policy = ReaderLagPolicy::kRestart};
+        ReaderWatchdog watchdog(asio_context, env, config);
+        CHECK(watchdog.check().empty());
+        CHECK(watchdog.actions_count() == 0);
+    }
+
+    SECTION("One watchdog per environment") {
+        ReaderWatchdog watchdog(asio_context, env, {});
+        CHECK_THROWS_AS(ReaderWatchdog(asio_context, env, {}), std::logic_error);
+    }
+}
+
+TEST_CASE("Reader watchdog live readers", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.max_size = 4_MiB;
+    db_config.growth_size = 1_MiB;
+    auto env{db::open_env(db_config)};
+    boost::asio::io_context asio_context;
+    ReaderWatchdog watchdog(asio_context, env, {.max_lag = 1, .policy = ReaderLagPolicy::kRestart});
+    size_t restarts{0};
+    watchdog.set_restart_handler([&restarts](const ReaderInfo&) { ++restarts; });
+
+    const Bytes key(sizeof(uint64_t), 0);
+    const auto write{[&env, &key](uint8_t fill) {
+        RWTxn txn{env};
+        Cursor cursor(txn, {"Watched"});
+        const Bytes value(2_KiB, fill);
+        cursor.upsert(to_slice(key), to_slice(value));
+        txn.commit(/*renew=*/false);
+    }};
+    write(1);
+
+    // A live reader of this process pins its snapshot : pages freed afterwards can't be reclaimed
+    auto reader_txn{env.start_read()};
+    bool map_full{false};
+    for (uint32_t i{2}; i < 100'000 && !map_full; ++i) {
+        try {
+            write(static_cast<uint8_t>(i));
+        } catch (const ::mdbx::map_full&) {
+            map_full = true;
+        }
+    }
+
+    // The reader is asked to restart but, as long as it doesn't, the writer fails cleanly instead of having it evicted
+    CHECK(map_full);
+    CHECK(restarts > 0);
+    CHECK(watchdog.actions_count() == restarts);
+    REQUIRE(watchdog.readers().size() == 1);
+    Cursor reader_cursor(reader_txn, {"Watched"});
+    const auto data{reader_cursor.find(to_slice(key), /*throw_notfound=*/false)};
+    REQUIRE(data);
+    CHECK(from_slice(data.value) == Bytes(2_KiB, 1));
+
+    // Pages are reclaimed once the reader is done
+    reader_txn.abort();
+    CHECK_NOTHROW(write(0xff));
+}
+
+}  // namespace zen::db
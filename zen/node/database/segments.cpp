@@ -0,0 +1,322 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "segments.hpp"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+#include <zen/core/common/endian.hpp>
+#include <zen/core/crypto/hash256.hpp>
+
+#include <zen/node/database/mdbx_tables.hpp>
+#include <zen/node/database/typed_map.hpp>
+
+namespace zen::db {
+
+static constexpr std::array<uint8_t, 4> kMagic{'Z', 'S', 'E', 'G'};
+
+[[noreturn]] static void throw_malformed(const std::filesystem::path& path, const std::string& what) {
+    throw std::runtime_error("Malformed segment " + path.string() + " : " + what);
+}
+
+Segment::Segment(const std::filesystem::path& path)
+    : path_{path},
+      file_{path.string().c_str(), boost::interprocess::read_only},
+      region_{file_, boost::interprocess::read_only} {
+    const ByteView data{static_cast<const uint8_t*>(region_.get_address()), region_.get_size()};
+    if (data.size() < kHeaderSize || std::memcmp(data.data(), kMagic.data(), kMagic.size()) != 0) {
+        throw_malformed(path_, "bad header");
+    }
+    if (endian::load_little_u16(&data[4]) != kVersion) throw_malformed(path_, "unsupported version");
+
+    const uint16_t flags{endian::load_little_u16(&data[6])};
+    first_ = endian::load_little_u32(&data[8]);
+    count_ = endian::load_little_u32(&data[12]);
+    const uint64_t index_offset{endian::load_little_u64(&data[16])};
+    const uint64_t hash_index_offset{endian::load_little_u64(&data[24])};
+    if (!count_ || first_ > std::numeric_limits<BlockNum>::max() - (count_ - 1)) throw_malformed(path_, "bad range");
+
+    const uint64_t index_size{(static_cast<uint64_t>(count_) + 1) * sizeof(uint64_t)};
+    if (index_offset < kHeaderSize || index_offset > data.size() || index_size > data.size() - index_offset) {
+        throw_malformed(path_, "bad index");
+    }
+    index_ = data.substr(index_offset, index_size);
+    if (endian::load_little_u64(&index_[0]) != kHeaderSize ||
+        endian::load_little_u64(&index_[count_ * sizeof(uint64_t)]) != index_offset) {
+        throw_malformed(path_, "bad index bounds");
+    }
+
+    if (flags & kHasHashIndex) {
+        const uint64_t hash_index_size{count_ * kHashEntrySize};
+        if (hash_index_offset < index_offset + index_size || hash_index_offset > data.size() ||
+            hash_index_size > data.size() - hash_index_offset) {
+            throw_malformed(path_, "bad hash index");
+        }
+        hash_index_ = data.substr(hash_index_offset, hash_index_size);
+    }
+}
+
+std::optional<ByteView> Segment::find(BlockNum height) const noexcept {
+    if (height < first_ || height - first_ >= count_) return std::nullopt;
+    const uint8_t* entry{&index_[(height - first_) * sizeof(uint64_t)]};
+    const uint64_t begin{endian::load_little_u64(entry)};
+    const uint64_t end{endian::load_little_u64(entry + sizeof(uint64_t))};
+    if (begin > end || end > region_.get_size()) return std::nullopt;  // Inner offsets are not validated on open
+    return ByteView{static_cast<const uint8_t*>(region_.get_address()) + begin, end - begin};
+}
+
+std::optional<BlockNum> Segment::find_height(const h256& hash) const noexcept {
+    // Binary search on entries sorted by hash
+    size_t low{0};
+    size_t high{hash_index_.size() / kHashEntrySize};
+    while (low < high) {
+        const size_t mid{low + (high - low) / 2};
+        const uint8_t* entry{&hash_index_[mid * kHashEntrySize]};
+        const int cmp{std::memcmp(entry, hash.data(), h256::size())};
+        if (cmp == 0) return endian::load_little_u32(entry + h256::size());
+        if (cmp < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return std::nullopt;
+}
+
+std::string Segment::file_name(std::string_view kind, BlockNum first, BlockNum last) {
+    // Zero padded heights so files list in height order
+    std::array<char, 32> range{};
+    std::ignore = std::snprintf(range.data(), range.size(), "-%010u-%010u", first, last);
+    return std::string(kind) + range.data() + kExtension;
+}
+
+SegmentWriter::SegmentWriter(std::filesystem::path path, BlockNum first, SegmentHashFunc hash_func)
+    : path_{std::move(path)}, first_{first}, hash_func_{std::move(hash_func)} {
+    tmp_path_ = path_;
+    tmp_path_ += ".tmp";
+    file_ = std::fopen(tmp_path_.string().c_str(), "wb");
+    if (!file_) throw std::runtime_error("Unable to create " + tmp_path_.string());
+    const std::array<uint8_t, Segment::kHeaderSize> placeholder{};
+    write(ByteView{placeholder.data(), placeholder.size()});
+}
+
+SegmentWriter::~SegmentWriter() {
+    if (!file_) return;
+    std::ignore = std::fclose(file_);
+    std::error_code ec;
+    std::ignore = std::filesystem::remove(tmp_path_, ec);
+}
+
+void SegmentWriter::write(ByteView data) {
+    if (std::fwrite(data.data(), 1, data.size(), file_) != data.size()) {
+        throw std::runtime_error("Unable to write " + tmp_path_.string());
+    }
+    size_ += data.size();
+}
+
+void SegmentWriter::append(ByteView record) {
+    if (offsets_.size() > std::numeric_limits<BlockNum>::max() - first_) {
+        throw std::overflow_error("Segment range exceeds max height");
+    }
+    if (hash_func_) hashes_.emplace_back(hash_func_(record), first_ + static_cast<BlockNum>(offsets_.size()));
+    offsets_.push_back(size_);
+    write(record);
+}
+
+void SegmentWriter::finish() {
+    if (!file_) throw std::logic_error("Segment already finished");
+    if (offsets_.empty()) throw std::logic_error("Empty segment");
+
+    std::array<uint8_t, sizeof(uint64_t)> u64{};
+    const uint64_t index_offset{size_};
+    offsets_.push_back(size_);
+    for (const auto offset : offsets_) {
+        endian::store_little_u64(u64.data(), offset);
+        write(ByteView{u64.data(), u64.size()});
+    }
+
+    uint64_t hash_index_offset{0};
+    if (hash_func_) {
+        hash_index_offset = size_;
+        std::ranges::sort(hashes_, {}, &std::pair<h256, BlockNum>::first);
+        std::array<uint8_t, Segment::kHashEntrySize> entry{};
+        for (const auto& [hash, height] : hashes_) {
+            std::memcpy(entry.data(), hash.data(), h256::size());
+            endian::store_little_u32(&entry[h256::size()], height);
+            write(ByteView{entry.data(), entry.size()});
+        }
+    }
+
+    std::array<uint8_t, Segment::kHeaderSize> header{};
+    std::memcpy(header.data(), kMagic.data(), kMagic.size());
+    endian::store_little_u16(&header[4], Segment::kVersion);
+    endian::store_little_u16(&header[6], hash_func_ ? Segment::kHasHashIndex : uint16_t{0});
+    endian::store_little_u32(&header[8], first_);
+    endian::store_little_u32(&header[12], static_cast<uint32_t>(offsets_.size() - 1));
+    endian::store_little_u64(&header[16], index_offset);
+    endian::store_little_u64(&header[24], hash_index_offset);
+    if (std::fseek(file_, 0, SEEK_SET) != 0 || std::fwrite(header.data(), 1, header.size(), file_) != header.size() ||
+        std::fflush(file_) != 0) {
+        throw std::runtime_error("Unable to write " + tmp_path_.string());
+    }
+
+    // Data must be on disk before the file appears (and before the records are erased from db)
+#if defined(_WIN32) || defined(_WIN64)
+    const int sync_result{::_commit(::_fileno(file_))};
+#else
+    const int sync_result{::fsync(::fileno(file_))};
+#endif
+    const int close_result{std::fclose(file_)};
+    file_ = nullptr;
+    if (sync_result != 0 || close_result != 0) {
+        std::error_code ec;
+        std::ignore = std::filesystem::remove(tmp_path_, ec);
+        throw std::runtime_error("Unable to sync " + tmp_path_.string());
+    }
+    std::filesystem::rename(tmp_path_, path_);
+}
+
+SegmentStore::SegmentStore(std::filesystem::path directory, std::string kind)
+    : directory_{std::move(directory)}, kind_{std::move(kind)} {
+    std::filesystem::create_directories(directory_);
+    const std::string prefix{kind_ + "-"};
+    const std::string tmp_suffix{std::string(Segment::kExtension) + ".tmp"};
+    std::vector<std::unique_ptr<Segment>> found;
+    std::vector<std::filesystem::path> unfinished;
+    for (const auto& item : std::filesystem::directory_iterator(directory_)) {
+        const auto file_name{item.path().filename().string()};
+        if (!item.is_regular_file() || !file_name.starts_with(prefix)) continue;
+        if (file_name.ends_with(tmp_suffix)) {
+            unfinished.push_back(item.path());  // Left behind by a writer which didn't finish
+        } else if (item.path().extension() == Segment::kExtension) {
+            found.push_back(std::make_unique<Segment>(item.path()));
+        }
+    }
+    for (const auto& path : unfinished) std::filesystem::remove(path);
+    std::ranges::sort(found, {}, [](const auto& segment) { return segment->first(); });
+    for (auto& segment : found) add(std::move(segment));
+}
+
+std::filesystem::path SegmentStore::segment_path(BlockNum first, BlockNum last) const {
+    return directory_ / Segment::file_name(kind_, first, last);
+}
+
+size_t SegmentStore::size() const {
+    std::shared_lock lock{mutex_};
+    return segments_.size();
+}
+
+std::optional<BlockNum> SegmentStore::max_height() const {
+    std::shared_lock lock{mutex_};
+    if (segments_.empty()) return std::nullopt;
+    return segments_.back()->last();
+}
+
+std::optional<ByteView> SegmentStore::find(BlockNum height) const {
+    std::shared_lock lock{mutex_};
+    if (segments_.empty() || height < segments_.front()->first() || height > segments_.back()->last()) {
+        return std::nullopt;
+    }
+    // Last segment starting at or below height
+    const auto it{
+        std::ranges::upper_bound(segments_, height, {}, [](const auto& segment) { return segment->first(); })};
+    return (*std::prev(it))->find(height);
+}
+
+std::optional<BlockNum> SegmentStore::find_height(const h256& hash) const {
+    std::shared_lock lock{mutex_};
+    // Most lookups are for recent blocks hence newest segments first
+    for (auto it{segments_.rbegin()}; it != segments_.rend(); ++it) {
+        if (auto height{(*it)->find_height(hash)}; height) return height;
+    }
+    return std::nullopt;
+}
+
+void SegmentStore::add(const std::filesystem::path& path) { add(std::make_unique<Segment>(path)); }
+
+void SegmentStore::add(std::unique_ptr<Segment> segment) {
+    std::unique_lock lock{mutex_};
+    if (!segments_.empty() && segment->first() != segments_.back()->last() + 1) {
+        throw std::runtime_error("Segment " + segment->path().string() + " does not extend " +
+                                 segments_.back()->path().string());
+    }
+    segments_.push_back(std::move(segment));
+}
+
+static h256 header_hash(ByteView header) {
+    crypto::Hash256 hasher(header);
+    h256 ret;
+    hasher.finalize(ret);
+    return ret;
+}
+
+std::optional<ByteView> read_header(::mdbx::txn& txn, const SegmentStore& segments, BlockNum height) {
+    if (auto data{segments.find(height)}; data) return data;
+    BlockNumCodec::buffer_type key{};
+    Cursor cursor(txn, tables::kHeaders);
+    const auto data{cursor.find(to_slice(BlockNumCodec::encode(key, height)), /*throw_notfound=*/false)};
+    if (!data) return std::nullopt;
+    return from_slice(data.value);
+}
+
+size_t freeze_headers(RWTxn& txn, SegmentStore& segments, BlockNum tip, const FreezeConfig& config) {
+    if (!config.segment_size) throw std::invalid_argument("Invalid argument : config.segment_size");
+
+    Cursor cursor(txn, tables::kHeaders);
+    BlockNumCodec::buffer_type key{};
+
+    // Headers already in segments are left behind by a previous run which stopped before committing
+    if (const auto max_height{segments.max_height()};
+        max_height && *max_height < std::numeric_limits<BlockNum>::max()) {
+        std::ignore = cursor_erase(cursor, BlockNumCodec::encode(key, *max_height + 1), CursorMoveDirection::Reverse);
+    }
+
+    size_t ret{0};
+    while (true) {
+        BlockNum first{0};
+        if (const auto max_height{segments.max_height()}; max_height) {
+            if (*max_height == std::numeric_limits<BlockNum>::max()) break;
+            first = *max_height + 1;
+        } else if (const auto data{cursor.to_first(/*throw_notfound=*/false)}; data) {
+            first = BlockNumCodec::decode(from_slice(data.key));
+        } else {
+            break;  // Nothing to freeze
+        }
+        const uint64_t last{static_cast<uint64_t>(first) + config.segment_size - 1};
+        if (last + config.min_depth > tip || last >= std::numeric_limits<BlockNum>::max()) break;
+
+        const auto path{segments.segment_path(first, static_cast<BlockNum>(last))};
+        SegmentWriter writer(path, first, config.hash_index ? SegmentHashFunc{header_hash} : nullptr);
+        auto data{cursor.find(to_slice(BlockNumCodec::encode(key, first)), /*throw_notfound=*/false)};
+        for (uint64_t height{first}; height <= last; ++height) {
+            if (!data || BlockNumCodec::decode(from_slice(data.key)) != height) {
+                throw std::runtime_error("Missing header " + std::to_string(height) + " to freeze");
+            }
+            writer.append(from_slice(data.value));
+            data = cursor.to_next(/*throw_notfound=*/false);
+        }
+        writer.finish();
+        segments.add(path);
+
+        std::ignore = cursor_erase(cursor, BlockNumCodec::encode(key, static_cast<BlockNum>(last + 1)),
+                                   CursorMoveDirection::Reverse);
+        ++ret;
+    }
+    return ret;
+}
+
+}  // namespace zen::db
@@ -0,0 +1,189 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <zen/core/common/base.hpp>
+#include <zen/core/types/hash.hpp>
+
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+/*
+ * Segments are immutable flat files holding the records of a contiguous range of block heights which are far enough
+ * below the tip to never change. They're written once, then memory mapped : a lookup is a bounds check and a couple
+ * of loads from the mapping, with no B-tree, no transaction and no reader slot involved.
+ *
+ * Layout (integers are little endian)
+ *   Header       : magic "ZSEG" | version u16 | flags u16 | first height u32 | count u32 | index offset u64 |
+ *                  hash index offset u64 (0 when absent)
+ *   Records      : values concatenated in height order
+ *   Height index : count + 1 offsets u64 of records within the file (the last one is the end of records)
+ *   Hash index   : (optional) count entries {hash h256 | height u32} sorted by hash
+ */
+
+//! \brief Computes the hash a record is indexed by in the hash index of a segment
+using SegmentHashFunc = std::function<h256(ByteView record)>;
+
+//! \brief A read-only memory mapped segment file
+class Segment {
+  public:
+    static constexpr size_t kHeaderSize{32};
+    static constexpr size_t kHashEntrySize{h256::size() + sizeof(uint32_t)};
+    static constexpr uint16_t kVersion{1};
+    static constexpr uint16_t kHasHashIndex{1};  // Flag
+    static constexpr const char* kExtension{".seg"};
+
+    //! \brief Maps the segment file and validates its layout
+    //! \throws std::runtime_error when the file is not a well formed segment
+    explicit Segment(const std::filesystem::path& path);
+
+    // Not copyable nor movable (views on the mapping are handed out)
+    Segment(const Segment&) = delete;
+    Segment& operator=(const Segment&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return path_; }
+    [[nodiscard]] BlockNum first() const noexcept { return first_; }
+    [[nodiscard]] BlockNum last() const noexcept { return first_ + count_ - 1; }
+    [[nodiscard]] uint32_t count() const noexcept { return count_; }
+    [[nodiscard]] bool has_hash_index() const noexcept { return !hash_index_.empty(); }
+
+    //! \brief Returns a view on the record at height (valid as long as the segment lives) if in range
+    [[nodiscard]] std::optional<ByteView> find(BlockNum height) const noexcept;
+
+    //! \brief Returns the height of the record with hash (requires the hash index)
+    [[nodiscard]] std::optional<BlockNum> find_height(const h256& hash) const noexcept;
+
+    //! \brief Returns the name of the segment file of a kind (e.g. "headers") for a range of heights
+    [[nodiscard]] static std::string file_name(std::string_view kind, BlockNum first, BlockNum last);
+
+  private:
+    std::filesystem::path path_;
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    BlockNum first_{0};
+    uint32_t count_{0};
+    ByteView index_;       // Height index
+    ByteView hash_index_;  // Hash index (empty when absent)
+};
+
+//! \brief Writes a segment file sequentially : records are appended in height order then finish() writes the indexes
+//! \remarks Data is written to a temporary file which is synced to disk and renamed on finish() : a segment file
+//! either exists whole or does not exist at all. An unfinished writer removes its temporary file on destruction
+class SegmentWriter {
+  public:
+    //! \param [in] path : the path of the segment file
+    //! \param [in] first : the height of the first record
+    //! \param [in] hash_func : if set, records are indexed by the hash computed by this function
+    SegmentWriter(std::filesystem::path path, BlockNum first, SegmentHashFunc hash_func = nullptr);
+    ~SegmentWriter();
+
+    // Not copyable nor movable
+    SegmentWriter(const SegmentWriter&) = delete;
+    SegmentWriter& operator=(const SegmentWriter&) = delete;
+
+    //! \brief Appends the record of the next height
+    void append(ByteView record);
+
+    //! \brief Writes indexes and header, then syncs and renames the file in place
+    //! \throws std::logic_error when no records have been appended
+    void finish();
+
+  private:
+    void write(ByteView data);
+
+    std::filesystem::path path_;
+    std::filesystem::path tmp_path_;
+    BlockNum first_;
+    SegmentHashFunc hash_func_;
+    std::FILE* file_{nullptr};
+    std::vector<uint64_t> offsets_;
+    std::vector<std::pair<h256, BlockNum>> hashes_;
+    uint64_t size_{0};
+};
+
+//! \brief The collection of segments of a kind found in a directory
+//! \details Segments must cover contiguous ranges of heights starting from the lowest one. Views on records are valid
+//! as long as the store lives
+//! \remarks Thread safe : segments can be added while other threads read
+class SegmentStore {
+  public:
+    //! \brief Opens all segment files of a kind in directory (which is created if missing)
+    //! \remarks Unfinished segment files of the kind (*.seg.tmp), left behind by a process which stopped while
+    //! writing, are deleted
+    //! \throws std::runtime_error when segments overlap or leave gaps
+    SegmentStore(std::filesystem::path directory, std::string kind);
+
+    // Not copyable nor movable
+    SegmentStore(const SegmentStore&) = delete;
+    SegmentStore& operator=(const SegmentStore&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& directory() const noexcept { return directory_; }
+    [[nodiscard]] const std::string& kind() const noexcept { return kind_; }
+
+    //! \brief Returns the path of the segment file for a range of heights
+    [[nodiscard]] std::filesystem::path segment_path(BlockNum first, BlockNum last) const;
+
+    //! \brief Returns the number of segments
+    [[nodiscard]] size_t size() const;
+
+    //! \brief Returns the highest height held by segments (if any)
+    [[nodiscard]] std::optional<BlockNum> max_height() const;
+
+    //! \brief Returns a view on the record at height if held by a segment
+    [[nodiscard]] std::optional<ByteView> find(BlockNum height) const;
+
+    //! \brief Returns the height of the record with hash if held by a segment with hash index
+    [[nodiscard]] std::optional<BlockNum> find_height(const h256& hash) const;
+
+    //! \brief Opens and registers a segment file which must extend the range of heights held
+    void add(const std::filesystem::path& path);
+
+  private:
+    void add(std::unique_ptr<Segment> segment);
+
+    const std::filesystem::path directory_;
+    const std::string kind_;
+    mutable std::shared_mutex mutex_;
+    std::vector<std::unique_ptr<Segment>> segments_;  // Sorted by height
+};
+
+//! \brief Settings of headers migration into segments
+struct FreezeConfig {
+    uint32_t segment_size{100'000};  // Number of heights per segment
+    uint32_t min_depth{90'000};      // Min distance from the tip of the last height of a segment
+    bool hash_index{true};           // Whether to build the hash -> height index
+};
+
+//! \brief Reads the header at height checking segments first then the Headers table
+//! \return A view on the header data (valid as long as either the store or the transaction live)
+[[nodiscard]] std::optional<ByteView> read_header(::mdbx::txn& txn, const SegmentStore& segments, BlockNum height);
+
+//! \brief Moves ranges of headers deep enough below the tip out of the Headers table into segment files
+//! \param [in] txn : A write transaction (its owner commits)
+//! \param [in] segments : The store the new segments are added to
+//! \param [in] tip : The height of the current tip
+//! \param [in] config : The migration settings
+//! \return The number of segments written
+//! \remarks Segments are written (and synced) before their headers are erased from the table : should the process
+//! stop before the transaction is committed the headers held by segments are erased on next call
+size_t freeze_headers(RWTxn& txn, SegmentStore& segments, BlockNum tip, const FreezeConfig& config = {});
+
+}  // namespace zen::db
@@ -0,0 +1,192 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <fstream>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <zen/core/common/cast.hpp>
+#include <zen/core/crypto/hash256.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/mdbx_tables.hpp>
+#include <zen/node/database/segments.hpp>
+#include <zen/node/database/typed_map.hpp>
+
+namespace zen::db {
+
+static std::string record_of(BlockNum height) { return "header-" + std::to_string(height); }
+
+static h256 hash_of(ByteView record) {
+    crypto::Hash256 hasher(record);
+    return h256(hasher.finalize());
+}
+
+TEST_CASE("Segment files", "[database]") {
+    const TempDirectory tmp_dir;
+    const auto path{tmp_dir.path() / Segment::file_name("test", 100, 109)};
+
+    SECTION("Write and read") {
+        {
+            SegmentWriter writer(path, 100, hash_of);
+            for (BlockNum height{100}; height < 110; ++height) {
+                writer.append(string_view_to_byte_view(record_of(height)));
+            }
+            writer.finish();
+        }
+        REQUIRE(std::filesystem::exists(path));
+        CHECK_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+        const Segment segment(path);
+        CHECK(segment.first() == 100);
+        CHECK(segment.last() == 109);
+        CHECK(segment.count() == 10);
+        CHECK(segment.has_hash_index());
+
+        for (BlockNum height{100}; height < 110; ++height) {
+            const auto record{segment.find(height)};
+            REQUIRE(record.has_value());
+            CHECK(byte_view_to_string_view(*record) == record_of(height));
+            CHECK(segment.find_height(hash_of(string_view_to_byte_view(record_of(height)))) == height);
+        }
+        CHECK_FALSE(segment.find(99).has_value());
+        CHECK_FALSE(segment.find(110).has_value());
+        CHECK_FALSE(segment.find_height(hash_of(string_view_to_byte_view(record_of(110)))).has_value());
+    }
+
+    SECTION("Without hash index") {
+        {
+            SegmentWriter writer(path, 100);
+            writer.append(string_view_to_byte_view(record_of(100)));
+            writer.append({});  // Empty records are allowed
+            writer.finish();
+        }
+        const Segment segment(path);
+        CHECK(segment.count() == 2);
+        CHECK_FALSE(segment.has_hash_index());
+        CHECK(segment.find(101).value().empty());
+        CHECK_FALSE(segment.find_height(hash_of(string_view_to_byte_view(record_of(100)))).has_value());
+    }
+
+    SECTION("Unfinished writer") {
+        {
+            SegmentWriter writer(path, 100);
+            writer.append(string_view_to_byte_view(record_of(100)));
+        }
+        CHECK_FALSE(std::filesystem::exists(path));
+        CHECK_FALSE(std::filesystem::exists(path.string() + ".tmp"));
+
+        SegmentWriter writer(path, 100);
+        CHECK_THROWS_AS(writer.finish(), std::logic_error);
+    }
+
+    SECTION("Malformed file") {
+        {
+            std::ofstream file(path, std::ios::binary);
+            file << "ZSEG but definitely not a segment file";
+        }
+        CHECK_THROWS_AS(Segment(path), std::runtime_error);
+    }
+}
+
+TEST_CASE("Segment store", "[database]") {
+    const TempDirectory tmp_dir;
+    const auto directory{tmp_dir.path() / "segments"};
+
+    const auto write_segment{[&directory](BlockNum first, BlockNum last) {
+        const auto path{directory / Segment::file_name("test", first, last)};
+        SegmentWriter writer(path, first);
+        for (BlockNum height{first}; height <= last; ++height) {
+            writer.append(string_view_to_byte_view(record_of(height)));
+        }
+        writer.finish();
+        return path;
+    }};
+
+    SegmentStore store(directory, "test");
+    CHECK(store.size() == 0);
+    CHECK_FALSE(store.max_height().has_value());
+    CHECK_FALSE(store.find(0).has_value());
+
+    store.add(write_segment(0, 9));
+    store.add(write_segment(10, 14));
+    CHECK(store.size() == 2);
+    CHECK(store.max_height() == 14);
+    CHECK(byte_view_to_string_view(store.find(9).value()) == record_of(9));
+    CHECK(byte_view_to_string_view(store.find(10).value()) == record_of(10));
+    CHECK_FALSE(store.find(15).has_value());
+
+    // Gaps are not allowed
+    CHECK_THROWS_AS(store.add(write_segment(20, 29)), std::runtime_error);
+
+    // Files of other kinds are ignored on reopen
+    std::filesystem::remove(directory / Segment::file_name("test", 20, 29));
+    {
+        SegmentWriter writer(directory / Segment::file_name("other", 0, 0), 0);
+        writer.append(string_view_to_byte_view(record_of(0)));
+        writer.finish();
+    }
+
+    // Unfinished segments of the kind are deleted on reopen
+    const auto unfinished{directory / (Segment::file_name("test", 15, 19) + ".tmp")};
+    const auto other_unfinished{directory / (Segment::file_name("other", 1, 1) + ".tmp")};
+    std::ofstream{unfinished} << "partial";
+    std::ofstream{other_unfinished} << "partial";
+    const SegmentStore reopened(directory, "test");
+    CHECK(reopened.size() == 2);
+    CHECK(reopened.max_height() == 14);
+    CHECK_FALSE(std::filesystem::exists(unfinished));
+    CHECK(std::filesystem::exists(other_unfinished));
+}
+
+TEST_CASE("Freeze headers", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    RWTxn txn{env};
+    tables::deploy_tables(*txn, tables::kChainDataTables);
+
+    static constexpr TypedMap<BlockNumCodec, StringCodec> kHeadersByNum{tables::kHeaders};
+    for (BlockNum height{0}; height < 25; ++height) kHeadersByNum.upsert(*txn, height, record_of(height));
+
+    SegmentStore segments(tmp_dir.path() / "segments", "headers");
+    const FreezeConfig config{.segment_size = 10, .min_depth = 4};
+
+    // Only ranges 0-9 and 10-19 are deep enough
+    CHECK(freeze_headers(txn, segments, /*tip=*/24, config) == 2);
+    CHECK(segments.size() == 2);
+    CHECK(segments.max_height() == 19);
+    CHECK(Cursor(txn, tables::kHeaders).get_map_stat().ms_entries == 5);
+    CHECK(freeze_headers(txn, segments, /*tip=*/24, config) == 0);
+
+    for (BlockNum height{0}; height < 25; ++height) {
+        const auto header{read_header(*txn, segments, height)};
+        REQUIRE(header.has_value());
+        CHECK(byte_view_to_string_view(*header) == record_of(height));
+    }
+    CHECK_FALSE(read_header(*txn, segments, 25).has_value());
+    CHECK(segments.find_height(hash_of(string_view_to_byte_view(record_of(7)))) == 7);
+    CHECK(segments.find_height(hash_of(string_view_to_byte_view(record_of(17)))) == 17);
+    CHECK_FALSE(segments.find_height(hash_of(string_view_to_byte_view(record_of(22)))).has_value());
+
+    SECTION("Headers left behind") {
+        // As if a previous run had stopped before committing the erasure
+        kHeadersByNum.upsert(*txn, 3, record_of(3));
+        kHeadersByNum.upsert(*txn, 19, record_of(19));
+        CHECK(freeze_headers(txn, segments, /*tip=*/24, config) == 0);
+        CHECK(Cursor(txn, tables::kHeaders).get_map_stat().ms_entries == 5);
+    }
+
+    SECTION("Missing headers") {
+        std::ignore = kHeadersByNum.erase(*txn, 22);
+        CHECK_THROWS_AS(freeze_headers(txn, segments, /*tip=*/40, config), std::runtime_error);
+        CHECK(segments.size() == 2);
+    }
+}
+
+}  // namespace zen::db
@@ -7,72 +7,72 @@
 
 #include "stages.hpp"
 
-#include <zen/core/common/endian.hpp>
+#include <array>
+#include <cstring>
+
+#include <zen/node/database/typed_map.hpp>
 
 namespace zen::db::stages {
 
-static BlockNum get_stage_data(mdbx::txn& txn, const char* stage_name, const db::MapConfig& domain,
-                               const char* key_prefix = nullptr) {
+//! \brief Typed view over the table of stages progresses
+static constexpr TypedMap<StringCodec, BlockNumCodec> kStageProgressMap{db::tables::kSyncStageProgress};
+
+//! \brief Max length of a stage record key (prefix included)
+static constexpr size_t kMaxStageKeyLength{64};
+
+//! \brief Composes the key of a stage record into the provided stack buffer
+static std::string_view get_stage_key(std::array<char, kMaxStageKeyLength>& buffer, const char* stage_name,
+                                      std::string_view key_prefix) {
+    const std::string_view name{stage_name};
+    if (key_prefix.length() + name.length() > buffer.size()) [[unlikely]] {
+        throw std::length_error("Stage key too long " + std::string(stage_name));
+    }
+    std::memcpy(buffer.data(), key_prefix.data(), key_prefix.length());
+    std::memcpy(&buffer[key_prefix.length()], name.data(), name.length());
+    return {buffer.data(), key_prefix.length() + name.length()};
+}
+
+static BlockNum get_stage_data(mdbx::txn& txn, const char* stage_name, std::string_view key_prefix = {}) {
     if (!is_known_stage(stage_name)) {
         throw std::invalid_argument("Unknown stage name " + std::string(stage_name));
     }
 
     try {
-        db::Cursor src(txn, domain);
-        std::string item_key{stage_name};
-        if (key_prefix) {
-            item_key.insert(0, std::string(key_prefix));
-        }
-        auto data{src.find(mdbx::slice(item_key.c_str()), /*throw_notfound*/ false)};
-        if (!data) {
-            return 0;
-        } else if (data.value.size() != sizeof(BlockNum)) [[unlikely]] {
-            throw std::length_error("Expected 4 bytes of data got " + std::to_string(data.value.size()));
-        }
-        return endian::load_big_u32(static_cast<uint8_t*>(data.value.data()));
+        std::array<char, kMaxStageKeyLength> key_buffer;
+        return kStageProgressMap.find(txn, get_stage_key(key_buffer, stage_name, key_prefix)).value_or(0);
     } catch (const mdbx::exception& ex) {
         std::string what("Error in " + std::string(__FUNCTION__) + " " + std::string(ex.what()));
         throw std::runtime_error(what);
     }
 }
 
-static void set_stage_data(mdbx::txn& txn, const char* stage_name, BlockNum block_num, const db::MapConfig& domain,
-                           const char* key_prefix = nullptr) {
+static void set_stage_data(mdbx::txn& txn, const char* stage_name, BlockNum block_num,
+                           std::string_view key_prefix = {}) {
     if (!is_known_stage(stage_name)) {
         throw std::invalid_argument("Unknown stage name");
     }
 
     try {
-        std::string item_key{stage_name};
-        if (key_prefix) {
-            item_key.insert(0, std::string(key_prefix));
-        }
-        Bytes stage_progress(sizeof(block_num), 0);
-        endian::store_big_u32(stage_progress.data(), block_num);
-        db::Cursor target(txn, domain);
-        mdbx::slice key(item_key.c_str());
-        mdbx::slice value{db::to_slice(stage_progress)};
-        target.upsert(key, value);
+        std::array<char, kMaxStageKeyLength> key_buffer;
+        kStageProgressMap.upsert(txn, get_stage_key(key_buffer, stage_name, key_prefix), block_num);
     } catch (const mdbx::exception& ex) {
         std::string what("Error in " + std::string(__FUNCTION__) + " " + std::string(ex.what()));
         throw std::runtime_error(what);
     }
 }
 
-BlockNum read_stage_progress(mdbx::txn& txn, const char* stage_name) {
-    return get_stage_data(txn, stage_name, db::tables::kSyncStageProgress);
-}
+BlockNum read_stage_progress(mdbx::txn& txn, const char* stage_name) { return get_stage_data(txn, stage_name); }
 
 BlockNum read_stage_prune_progress(mdbx::txn& txn, const char* stage_name) {
-    return get_stage_data(txn, stage_name, db::tables::kSyncStageProgress, "prune_");
+    return get_stage_data(txn, stage_name, "prune_");
 }
 
 void write_stage_progress(mdbx::txn& txn, const char* stage_name, BlockNum block_num) {
-    set_stage_data(txn, stage_name, block_num, db::tables::kSyncStageProgress);
+    set_stage_data(txn, stage_name, block_num);
 }
 
 void write_stage_prune_progress(mdbx::txn& txn, const char* stage_name, BlockNum block_num) {
-    set_stage_data(txn, stage_name, block_num, db::tables::kSyncStageProgress, "prune_");
+    set_stage_data(txn, stage_name, block_num, "prune_");
 }
 
 bool is_known_stage(const char* name) {
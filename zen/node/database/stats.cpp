@@ -0,0 +1,135 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "stats.hpp"
+
+#include <zen/core/common/misc.hpp>
+
+#include <zen/node/common/log.hpp>
+#include <zen/node/database/mdbx_tables.hpp>
+
+namespace zen::db {
+
+// The GC (aka freelist) is always the first map of an environment
+static constexpr MDBX_dbi kGcDbi{0};
+
+static MapStats to_map_stats(std::string name, const MDBX_stat& stat) {
+    return {.name = std::move(name),
+            .page_size = stat.ms_psize,
+            .depth = stat.ms_depth,
+            .entries = stat.ms_entries,
+            .branch_pages = stat.ms_branch_pages,
+            .leaf_pages = stat.ms_leaf_pages,
+            .overflow_pages = stat.ms_overflow_pages};
+}
+
+std::vector<MapStats> get_maps_stats(::mdbx::txn& txn, std::span<const MapConfig> maps) {
+    std::vector<MapStats> ret;
+    ret.reserve(maps.size());
+    for (const auto& config : maps) {
+        if (!has_map(txn, config.name)) continue;
+        const auto handle{open_cached_map(txn, config)};
+        ret.push_back(to_map_stats(config.name, txn.get_map_stat(handle)));
+    }
+    return ret;
+}
+
+EnvStats get_env_stats(::mdbx::txn& txn) {
+    MDBX_envinfo info;
+    ::mdbx::error::success_or_throw(::mdbx_env_info_ex(txn.env(), txn, &info, sizeof(info)));
+    MDBX_stat gc_stat;
+    ::mdbx::error::success_or_throw(::mdbx_dbi_stat(txn, kGcDbi, &gc_stat, sizeof(gc_stat)));
+
+    return {.page_size = info.mi_dxb_pagesize,
+            .geo_lower = info.mi_geo.lower,
+            .geo_upper = info.mi_geo.upper,
+            .geo_current = info.mi_geo.current,
+            .geo_growth = info.mi_geo.grow,
+            .geo_shrink = info.mi_geo.shrink,
+            .last_pgno = info.mi_last_pgno,
+            .recent_txn_id = info.mi_recent_txnid,
+            .reader_lag = info.mi_recent_txnid - std::min(info.mi_latter_reader_txnid, info.mi_recent_txnid),
+            .readers_num = info.mi_numreaders,
+            .readers_max = info.mi_maxreaders,
+            .gc_entries = gc_stat.ms_entries,
+            .gc_pages = gc_stat.ms_branch_pages + gc_stat.ms_leaf_pages + gc_stat.ms_overflow_pages,
+            .unsynced_bytes = info.mi_unsync_volume,
+            .spilled_pages = info.mi_pgop_stat.spill,
+            .unspilled_pages = info.mi_pgop_stat.unspill};
+}
+
+void log_stats(const MapStats& stats) {
+    std::ignore =
+        log::Info("Table stats",
+                  {"name", stats.name, "entries", std::to_string(stats.entries), "depth", std::to_string(stats.depth),
+                   "branch", std::to_string(stats.branch_pages), "leaf", std::to_string(stats.leaf_pages), "overflow",
+                   std::to_string(stats.overflow_pages), "size", to_human_bytes(stats.size())});
+}
+
+void log_stats(const EnvStats& stats) {
+    std::ignore = log::Info("Database stats",
+                            {"size",       to_human_bytes(stats.geo_current),
+                             "used",       to_human_bytes((stats.last_pgno + 1) * stats.page_size),
+                             "upper",      to_human_bytes(stats.geo_upper),
+                             "growth",     to_human_bytes(stats.geo_growth),
+                             "readers",    std::to_string(stats.readers_num) + "/" + std::to_string(stats.readers_max),
+                             "reader lag", std::to_string(stats.reader_lag),
+                             "gc entries", std::to_string(stats.gc_entries),
+                             "gc pages",   std::to_string(stats.gc_pages),
+                             "unsynced",   to_human_bytes(stats.unsynced_bytes),
+                             "spilled",    std::to_string(stats.spilled_pages)});
+}
+
+void log_stats(const CommitStats& stats) {
+    std::ignore = log::Info(
+        "Commit stats",
+        {"dirty", to_human_bytes(stats.dirty_bytes), "preparation", std::to_string(stats.preparation.count()) + "us",
+         "gc", std::to_string(stats.gc.count()) + "us", "write", std::to_string(stats.write.count()) + "us", "sync",
+         std::to_string(stats.sync.count()) + "us", "whole", std::to_string(stats.whole.count()) + "us"});
+}
+
+StatsLogger::StatsLogger(boost::asio::io_context& asio_context, ::mdbx::env env, uint32_t interval_seconds)
+    : env_{env}, timer_{asio_context, interval_seconds * 1'000U, [this]() -> bool {
+                            try {
+                                log_now();
+                            } catch (const std::exception& ex) {
+                                std::ignore = log::Error("Unable to collect db stats", {"exception", ex.what()});
+                            }
+                            return true;
+                        }} {}
+
+void StatsLogger::record(const CommitStats& stats) {
+    std::scoped_lock lock{mutex_};
+    ++commits_;
+    committed_bytes_ += stats.dirty_bytes;
+    commit_time_ += stats.whole;
+    max_commit_time_ = std::max(max_commit_time_, stats.whole);
+}
+
+void StatsLogger::log_now() {
+    auto txn{env_.start_read()};
+    const auto env_stats{get_env_stats(txn)};
+    log_stats(env_stats);
+    for (const auto& map_stats : get_maps_stats(txn, tables::kChainDataTables)) log_stats(map_stats);
+    txn.abort();
+
+    std::scoped_lock lock{mutex_};
+    if (commits_) {
+        std::ignore =
+            log::Info("Commits stats",
+                      {"count", std::to_string(commits_), "dirty", to_human_bytes(committed_bytes_), "avg",
+                       std::to_string(commit_time_.count() / static_cast<int64_t>(commits_)) + "us", "max",
+                       std::to_string(max_commit_time_.count()) + "us", "spilled",
+                       std::to_string(env_stats.spilled_pages - std::min(spilled_pages_, env_stats.spilled_pages))});
+    }
+    commits_ = 0;
+    committed_bytes_ = 0;
+    commit_time_ = std::chrono::microseconds{0};
+    max_commit_time_ = std::chrono::microseconds{0};
+    spilled_pages_ = env_stats.spilled_pages;
+}
+
+}  // namespace zen::db
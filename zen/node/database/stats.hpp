@@ -0,0 +1,109 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <boost/asio/io_context.hpp>
+
+#include <zen/node/common/asio_timer.hpp>
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+//! \brief Statistics of a map (aka table)
+struct MapStats {
+    std::string name;            // Name of the map
+    uint32_t page_size{0};       // Size of a database page
+    uint32_t depth{0};           // Depth of the B-tree
+    uint64_t entries{0};         // Number of records
+    uint64_t branch_pages{0};    // Number of internal (non-leaf) pages
+    uint64_t leaf_pages{0};      // Number of leaf pages
+    uint64_t overflow_pages{0};  // Number of large/overflow pages
+
+    //! \brief Overall size of the pages used by the map
+    [[nodiscard]] uint64_t size() const noexcept { return (branch_pages + leaf_pages + overflow_pages) * page_size; }
+};
+
+//! \brief Statistics of an environment
+struct EnvStats {
+    uint32_t page_size{0};        // Size of a database page
+    uint64_t geo_lower{0};        // Lower limit for datafile size
+    uint64_t geo_upper{0};        // Upper limit for datafile size
+    uint64_t geo_current{0};      // Current datafile size
+    uint64_t geo_growth{0};       // Datafile growth step
+    uint64_t geo_shrink{0};       // Datafile shrink threshold
+    uint64_t last_pgno{0};        // Number of the last used page
+    uint64_t recent_txn_id{0};    // Id of the last committed transaction
+    uint64_t reader_lag{0};       // Number of transactions the oldest reader is lagging behind
+    uint32_t readers_num{0};      // Number of reader slots in use
+    uint32_t readers_max{0};      // Max number of reader slots
+    uint64_t gc_entries{0};       // Number of records in the GC (aka freelist)
+    uint64_t gc_pages{0};         // Number of pages used by the GC itself
+    uint64_t unsynced_bytes{0};   // Amount of committed data not yet synced to disk
+    uint64_t spilled_pages{0};    // Overall number of dirty pages spilled to disk (since env was opened)
+    uint64_t unspilled_pages{0};  // Overall number of spilled pages brought back (since env was opened)
+};
+
+//! \brief Returns the statistics of the provided maps
+//! \remarks Maps not existing in the database are skipped
+[[nodiscard]] std::vector<MapStats> get_maps_stats(::mdbx::txn& txn, std::span<const MapConfig> maps);
+
+//! \brief Returns the statistics of the environment as seen by the provided transaction
+[[nodiscard]] EnvStats get_env_stats(::mdbx::txn& txn);
+
+//! \brief Logs the statistics of a map
+void log_stats(const MapStats& stats);
+
+//! \brief Logs the statistics of an environment
+void log_stats(const EnvStats& stats);
+
+//! \brief Logs the metrics of a commit
+void log_stats(const CommitStats& stats);
+
+//! \brief Periodically logs the statistics of an environment and of its chain data tables along with the commit
+//! metrics reported by writers in the meantime
+//! \remarks Logging happens on the asio context's thread(s) by means of a read-only transaction
+class StatsLogger {
+  public:
+    //! \param [in] asio_context : the asio context driving the timer
+    //! \param [in] env : the environment to report statistics of
+    //! \param [in] interval_seconds : the logging interval (usually NodeSettings::sync_loop_log_interval_seconds)
+    StatsLogger(boost::asio::io_context& asio_context, ::mdbx::env env, uint32_t interval_seconds);
+
+    // Not copyable nor movable
+    StatsLogger(const StatsLogger&) = delete;
+    StatsLogger& operator=(const StatsLogger&) = delete;
+
+    void start() { timer_.start(); }
+    void stop() { timer_.stop(); }
+
+    //! \brief Accounts the metrics of a commit for next logging
+    //! \remarks Thread safe
+    void record(const CommitStats& stats);
+
+    //! \brief Logs statistics immediately
+    void log_now();
+
+  private:
+    ::mdbx::env env_;
+
+    std::mutex mutex_;
+    uint64_t commits_{0};                       // Commits recorded since last logging
+    uint64_t committed_bytes_{0};               // Dirty data flushed by commits since last logging
+    std::chrono::microseconds commit_time_{0};  // Overall duration of commits since last logging
+    std::chrono::microseconds max_commit_time_{0};
+    uint64_t spilled_pages_{0};  // Spilled pages at last logging
+
+    Timer timer_;  // Last : it's stopped before the state its callback works on is destroyed
+};
+
+}  // namespace zen::db
@@ -0,0 +1,75 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <zen/core/common/endian.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/mdbx_tables.hpp>
+#include <zen/node/database/stats.hpp>
+
+namespace zen::db {
+
+TEST_CASE("Database stats", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    auto env{db::open_env(db_config)};
+
+    RWTxn txn(env);
+    tables::deploy_tables(*txn, tables::kChainDataTables);
+    {
+        Cursor headers(txn, tables::kHeaders);
+        const Bytes value(1_KiB, 0xaa);
+        for (uint16_t i{0}; i < 1'000; ++i) {
+            Bytes key(2, 0);
+            endian::store_big_u16(key.data(), i);
+            headers.upsert(to_slice(key), to_slice(value));
+        }
+    }
+    txn.commit();
+
+    SECTION("Commit") {
+        const auto& stats{txn.last_commit_stats()};
+        CHECK(stats.dirty_bytes >= 1'000 * 1_KiB);
+        CHECK(stats.whole >= stats.write);
+    }
+
+    SECTION("Maps") {
+        const auto maps_stats{get_maps_stats(*txn, tables::kChainDataTables)};
+        REQUIRE(maps_stats.size() == tables::kChainDataTables.size());
+        for (const auto& stats : maps_stats) {
+            if (stats.name != tables::kHeaders.name) continue;
+            CHECK(stats.entries == 1'000);
+            CHECK(stats.depth > 1);
+            CHECK(stats.branch_pages > 0);
+            CHECK(stats.leaf_pages > 0);
+            CHECK(stats.size() >= 1'000 * 1_KiB);
+        }
+
+        const MapConfig missing{"Missing"};
+        CHECK(get_maps_stats(*txn, {&missing, 1}).empty());
+    }
+
+    SECTION("Environment") {
+        const auto stats{get_env_stats(*txn)};
+        CHECK(stats.page_size == env.get_pagesize());
+        CHECK(stats.geo_current >= (stats.last_pgno + 1) * stats.page_size);
+        CHECK(stats.recent_txn_id > 0);
+        CHECK(stats.readers_num <= stats.readers_max);
+    }
+
+    SECTION("Logger") {
+        boost::asio::io_context context;
+        StatsLogger logger(context, env, /*interval_seconds=*/1);
+        logger.record(txn.last_commit_stats());
+        CHECK_NOTHROW(logger.log_now());
+    }
+
+    txn.abort();
+}
+
+}  // namespace zen::db
@@ -0,0 +1,220 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+
+#include <zen/core/common/base.hpp>
+#include <zen/core/common/cast.hpp>
+#include <zen/core/common/endian.hpp>
+#include <zen/core/types/hash.hpp>
+
+#include <zen/node/common/version.hpp>
+#include <zen/node/database/mdbx.hpp>
+
+namespace zen::db {
+
+//! \brief A codec translates values of a type to/from their db representation
+//! \details Encoding writes into a fixed size buffer_type living on the caller's stack (codecs of types already
+//! laid out as bytes return a view on the value itself and use an empty buffer). Decoding gets a view on db data
+//! and returns a decoded_type which is either a small value or a view into db pages (valid as long as the
+//! transaction is alive and the map is not modified)
+template <typename C>
+concept MapCodec = requires(typename C::buffer_type& buffer, const typename C::value_type& value, ByteView data) {
+    { C::encode(buffer, value) } -> std::same_as<ByteView>;
+    { C::decode(data) } -> std::same_as<typename C::decoded_type>;
+};
+
+namespace detail {
+    [[noreturn]] inline void throw_unexpected_length(size_t expected, size_t actual) {
+        throw std::length_error("Expected " + std::to_string(expected) + " bytes of data got " +
+                                std::to_string(actual));
+    }
+}  // namespace detail
+
+//! \brief Codec for unsigned integers stored big endian (hence sorted numerically)
+template <std::unsigned_integral T>
+struct BigEndianCodec {
+    using value_type = T;
+    using decoded_type = T;
+    using buffer_type = std::array<uint8_t, sizeof(T)>;
+
+    static ByteView encode(buffer_type& buffer, const T value) noexcept {
+        intx::be::unsafe::store(buffer.data(), value);
+        return {buffer};
+    }
+    static T decode(const ByteView data) {
+        if (data.length() != sizeof(T)) [[unlikely]]
+            detail::throw_unexpected_length(sizeof(T), data.length());
+        return intx::be::unsafe::load<T>(data.data());
+    }
+};
+
+//! \brief Codec for block heights
+using BlockNumCodec = BigEndianCodec<BlockNum>;
+
+//! \brief Codec for fixed size hashes (e.g. h256): encoding is a view on the hash itself
+template <uint32_t BITS>
+struct HashCodec {
+    using value_type = Hash<BITS>;
+    using decoded_type = Hash<BITS>;
+    using buffer_type = std::monostate;
+
+    static ByteView encode(buffer_type&, const value_type& value) noexcept {
+        return {value.data(), value_type::size()};
+    }
+    static value_type decode(const ByteView data) {
+        if (data.length() != value_type::size()) [[unlikely]]
+            detail::throw_unexpected_length(value_type::size(), data.length());
+        return value_type(data);
+    }
+};
+
+//! \brief Codec for Version : Major, Minor and Patch as big endian u32
+struct VersionCodec {
+    using value_type = Version;
+    using decoded_type = Version;
+    using buffer_type = std::array<uint8_t, 3 * sizeof(uint32_t)>;
+
+    static ByteView encode(buffer_type& buffer, const Version& value) noexcept {
+        endian::store_big_u32(&buffer[0], value.Major);
+        endian::store_big_u32(&buffer[4], value.Minor);
+        endian::store_big_u32(&buffer[8], value.Patch);
+        return {buffer};
+    }
+    static Version decode(const ByteView data) {
+        if (data.length() != std::tuple_size_v<buffer_type>) [[unlikely]]
+            detail::throw_unexpected_length(std::tuple_size_v<buffer_type>, data.length());
+        return {endian::load_big_u32(&data[0]), endian::load_big_u32(&data[4]), endian::load_big_u32(&data[8])};
+    }
+};
+
+//! \brief Codec for strings : both encoding and decoding are views
+struct StringCodec {
+    using value_type = std::string_view;
+    using decoded_type = std::string_view;
+    using buffer_type = std::monostate;
+
+    static ByteView encode(buffer_type&, const std::string_view value) noexcept {
+        return string_view_to_byte_view(value);
+    }
+    static std::string_view decode(const ByteView data) noexcept { return byte_view_to_string_view(data); }
+};
+
+//! \brief Codec for raw bytes : both encoding and decoding are views
+struct BytesCodec {
+    using value_type = ByteView;
+    using decoded_type = ByteView;
+    using buffer_type = std::monostate;
+
+    static ByteView encode(buffer_type&, const ByteView value) noexcept { return value; }
+    static ByteView decode(const ByteView data) noexcept { return data; }
+};
+
+//! \brief Values of multi-value maps with fixed size values (MDBX_DUPFIXED) readable in place : db pages hold them
+//! packed at any (even) offset hence they must be trivially copyable with no alignment requirement (e.g. raw hashes
+//! as std::array<uint8_t, 32> or BigEndianValue, but not h256 which is 4 bytes aligned)
+template <typename T>
+concept FixedSizeValue = std::is_trivially_copyable_v<T> && alignof(T) == 1;
+
+//! \brief An unsigned integer stored big endian as a fixed size value (e.g. block numbers in dupfixed maps)
+template <std::unsigned_integral T>
+struct BigEndianValue {
+    std::array<uint8_t, sizeof(T)> bytes;
+
+    [[nodiscard]] T value() const noexcept { return intx::be::unsafe::load<T>(bytes.data()); }
+};
+
+//! \brief Returns a view over packed fixed size values
+//! \throws std::length_error when data length is not a multiple of the value size
+template <FixedSizeValue T>
+[[nodiscard]] std::span<const T> as_values(const ByteView data) {
+    if (data.length() % sizeof(T)) [[unlikely]]
+        throw std::length_error("Expected a multiple of " + std::to_string(sizeof(T)) + " bytes of data got " +
+                                std::to_string(data.length()));
+    return {reinterpret_cast<const T*>(data.data()), data.length() / sizeof(T)};
+}
+
+//! \brief Returns the first page of values of key as typed values (see cursor_get_multiple)
+template <FixedSizeValue T>
+[[nodiscard]] std::span<const T> cursor_get_multiple(::mdbx::cursor& cursor, const ByteView key) {
+    return as_values<T>(cursor_get_multiple(cursor, key));
+}
+
+//! \brief Returns the next page of values of the current key as typed values (see cursor_next_multiple)
+template <FixedSizeValue T>
+[[nodiscard]] std::span<const T> cursor_next_multiple(::mdbx::cursor& cursor) {
+    return as_values<T>(cursor_next_multiple(cursor));
+}
+
+//! \brief Invokes func on every page of values of key as a std::span<const T>
+//! \return The overall number of values read
+template <FixedSizeValue T, std::invocable<std::span<const T>> Func>
+size_t cursor_for_each_multiple(::mdbx::cursor& cursor, const ByteView key, Func&& func) {
+    size_t ret{0};
+    for (auto values{cursor_get_multiple<T>(cursor, key)}; !values.empty(); values = cursor_next_multiple<T>(cursor)) {
+        ret += values.size();
+        func(values);
+    }
+    return ret;
+}
+
+//! \brief A compile-time typed view over a map (aka table)
+//! \details Keys and values are encoded into stack buffers and decoded straight from db pages: point accessors
+//! do not allocate. The map handle is resolved by open_cached_map and no cursor is involved
+template <MapCodec KeyCodec, MapCodec ValueCodec>
+class TypedMap {
+  public:
+    using key_type = typename KeyCodec::value_type;
+    using value_type = typename ValueCodec::value_type;
+    using decoded_type = typename ValueCodec::decoded_type;
+
+    constexpr explicit TypedMap(const MapConfig& config) noexcept : config_{config} {}
+
+    [[nodiscard]] constexpr const MapConfig& config() const noexcept { return config_; }
+
+    //! \brief Returns the decoded value stored for the key (if any)
+    //! \remarks Views returned by decoding are valid until the transaction ends or the map is modified
+    [[nodiscard]] std::optional<decoded_type> find(::mdbx::txn& txn, const key_type& key) const {
+        typename KeyCodec::buffer_type key_buffer;
+        const ::mdbx::slice key_slice{to_slice(KeyCodec::encode(key_buffer, key))};
+        ::mdbx::slice data{};
+        const auto rc{::mdbx_get(txn, open_cached_map(txn, config_).dbi, &key_slice, &data)};
+        if (rc == MDBX_NOTFOUND) return std::nullopt;
+        ::mdbx::error::success_or_throw(rc);
+        return ValueCodec::decode(from_slice(data));
+    }
+
+    //! \brief Inserts or updates the value for the key
+    void upsert(::mdbx::txn& txn, const key_type& key, const value_type& value) const {
+        typename KeyCodec::buffer_type key_buffer;
+        typename ValueCodec::buffer_type value_buffer;
+        txn.upsert(open_cached_map(txn, config_), to_slice(KeyCodec::encode(key_buffer, key)),
+                   to_slice(ValueCodec::encode(value_buffer, value)));
+    }
+
+    //! \brief Erases the record for the key
+    //! \return Whether the record existed
+    bool erase(::mdbx::txn& txn, const key_type& key) const {
+        typename KeyCodec::buffer_type key_buffer;
+        return txn.erase(open_cached_map(txn, config_), to_slice(KeyCodec::encode(key_buffer, key)));
+    }
+
+  private:
+    const MapConfig config_;
+};
+
+}  // namespace zen::db
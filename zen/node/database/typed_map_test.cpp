@@ -0,0 +1,163 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <catch2/catch.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/database/typed_map.hpp>
+
+namespace zen::db {
+
+TEST_CASE("Map codecs", "[database]") {
+    SECTION("BlockNum") {
+        BlockNumCodec::buffer_type buffer;
+        const auto encoded{BlockNumCodec::encode(buffer, 0x01020304)};
+        CHECK(encoded == ByteView{buffer});
+        CHECK(encoded == Bytes{0x01, 0x02, 0x03, 0x04});
+        CHECK(BlockNumCodec::decode(encoded) == 0x01020304);
+        CHECK_THROWS_AS(BlockNumCodec::decode(encoded.substr(1)), std::length_error);
+    }
+
+    SECTION("h256") {
+        const h256 hash{0xdeadbeef};
+        HashCodec<256>::buffer_type buffer;
+        const auto encoded{HashCodec<256>::encode(buffer, hash)};
+        CHECK(encoded.data() == hash.data());  // No copy
+        CHECK(encoded.length() == h256::size());
+        CHECK(HashCodec<256>::decode(encoded) == hash);
+        CHECK_THROWS_AS(HashCodec<256>::decode(encoded.substr(1)), std::length_error);
+    }
+
+    SECTION("Version") {
+        const Version version{1, 2, 3};
+        VersionCodec::buffer_type buffer;
+        const auto encoded{VersionCodec::encode(buffer, version)};
+        CHECK(encoded == Bytes{0, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0, 3});
+        CHECK(VersionCodec::decode(encoded) == version);
+        CHECK_THROWS_AS(VersionCodec::decode(encoded.substr(4)), std::length_error);
+    }
+}
+
+TEST_CASE("Typed map", "[database]") {
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    RWTxn txn{env};
+
+    const TypedMap<HashCodec<256>, BlockNumCodec> heights{MapConfig{"HashToHeight"}};
+    const TypedMap<BlockNumCodec, StringCodec> names{MapConfig{"HeightToName"}};
+
+    const h256 hash1{1};
+    const h256 hash2{2};
+    CHECK_FALSE(heights.find(*txn, hash1).has_value());
+    heights.upsert(*txn, hash1, 100);
+    heights.upsert(*txn, hash2, 200);
+    CHECK(heights.find(*txn, hash1) == 100);
+    CHECK(heights.find(*txn, hash2) == 200);
+    heights.upsert(*txn, hash2, 300);
+    CHECK(heights.find(*txn, hash2) == 300);
+
+    CHECK(heights.erase(*txn, hash1));
+    CHECK_FALSE(heights.erase(*txn, hash1));
+    CHECK_FALSE(heights.find(*txn, hash1).has_value());
+
+    names.upsert(*txn, 1, "first");
+    txn.commit();
+
+    // Decoded view points into db pages
+    const auto name{names.find(*txn, 1)};
+    REQUIRE(name.has_value());
+    CHECK(*name == "first");
+
+    // Keys are big endian hence sorted numerically
+    names.upsert(*txn, 256, "second");
+    Cursor cursor(txn, names.config());
+    CHECK(BlockNumCodec::decode(from_slice(cursor.to_last().key)) == 256);
+}
+
+TEST_CASE("Multiple values reads", "[database]") {
+    using RawHash = std::array<uint8_t, h256::size()>;
+    static_assert(FixedSizeValue<RawHash>);
+    static_assert(FixedSizeValue<BigEndianValue<BlockNum>>);
+    static_assert(!FixedSizeValue<uint64_t>);
+
+    const TempDirectory tmp_dir;
+    EnvConfig db_config{tmp_dir.path().string(), /*create*/ true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    RWTxn txn{env};
+
+    const MapConfig config{"BlockLists", mdbx::key_mode::usual, mdbx::value_mode::multi_samelength};
+    Cursor cursor(txn, config);
+    const Bytes key1{'a'};
+    const Bytes key2{'b'};
+    const Bytes missing{'c'};
+
+    // Enough values to span several pages
+    static constexpr BlockNum kCount{10'000};
+    Bytes value(sizeof(BlockNum), 0);
+    for (BlockNum i{0}; i < kCount; ++i) {
+        endian::store_big_u32(value.data(), i);
+        cursor.upsert(to_slice(key1), to_slice(value));
+        endian::store_big_u32(value.data(), i * 2);
+        cursor.upsert(to_slice(key2), to_slice(value));
+    }
+
+    SECTION("Pages") {
+        const auto first{cursor_get_multiple<BigEndianValue<BlockNum>>(cursor, key2)};
+        REQUIRE_FALSE(first.empty());
+        CHECK(first.size() < kCount);
+        CHECK(first[0].value() == 0);
+        CHECK(first[1].value() == 2);
+
+        const auto second{cursor_next_multiple<BigEndianValue<BlockNum>>(cursor)};
+        REQUIRE_FALSE(second.empty());
+        CHECK(second[0].value() == first.size() * 2);
+    }
+
+    SECTION("Whole set") {
+        size_t pages{0};
+        BlockNum expected{0};
+        bool in_order{true};
+        const auto count{cursor_for_each_multiple<BigEndianValue<BlockNum>>(
+            cursor, key1, [&](std::span<const BigEndianValue<BlockNum>> values) {
+                ++pages;
+                for (const auto& item : values) in_order &= item.value() == expected++;
+            })};
+        CHECK(count == kCount);
+        CHECK(in_order);
+        CHECK(pages > 1);
+        CHECK(pages < kCount / 100);
+
+        // Reading stops at the end of the key's values
+        CHECK(cursor_next_multiple<BigEndianValue<BlockNum>>(cursor).empty());
+    }
+
+    SECTION("Not found") {
+        CHECK(cursor_get_multiple<BigEndianValue<BlockNum>>(cursor, missing).empty());
+        CHECK(cursor_for_each_multiple<RawHash>(cursor, missing, [](auto) { FAIL("No values expected"); }) == 0);
+    }
+
+    SECTION("Unexpected length") {
+        const Bytes key3{'d'};
+        for (uint8_t i{0}; i < 3; ++i) {
+            value.back() = i;
+            cursor.upsert(to_slice(key3), to_slice(value));
+        }
+        CHECK(cursor_get_multiple<BigEndianValue<BlockNum>>(cursor, key3).size() == 3);
+        CHECK_THROWS_AS(cursor_get_multiple<RawHash>(cursor, key3), std::length_error);
+        CHECK_THROWS_AS(as_values<RawHash>(Bytes(33, 0)), std::length_error);
+    }
+
+    SECTION("Not dupfixed") {
+        Cursor multi(txn, {"Multi", mdbx::key_mode::usual, mdbx::value_mode::multi});
+        multi.upsert(to_slice(key1), to_slice(value));
+        CHECK_THROWS(cursor_get_multiple(multi, key1));
+    }
+}
+
+}  // namespace zen::db
@@ -0,0 +1,57 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <algorithm>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <zen/node/etl/util.hpp>
+
+namespace zen::etl {
+
+//! \brief In-memory collection of entries accumulated up to an optimal size before being sorted and flushed to disk
+class Buffer : private boost::noncopyable {
+  public:
+    explicit Buffer(size_t optimal_size) : optimal_size_{optimal_size} {}
+
+    //! \brief Appends an entry to the buffer
+    void put(Entry&& entry) {
+        size_ += entry.size();
+        entries_.push_back(std::move(entry));
+    }
+
+    //! \brief Removes all entries
+    void clear() noexcept {
+        entries_.clear();
+        size_ = 0;
+    }
+
+    //! \brief Whether the accumulated size has reached the optimal size
+    [[nodiscard]] bool overflows() const noexcept { return size_ >= optimal_size_; }
+
+    //! \brief Sorts entries in key (and value) order
+    void sort() { std::sort(entries_.begin(), entries_.end()); }
+
+    //! \brief Returns the cumulative size of keys and values accumulated
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    //! \brief Returns the number of entries held
+    [[nodiscard]] size_t length() const noexcept { return entries_.size(); }
+
+    //! \brief Whether the buffer holds no entries
+    [[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+
+    [[nodiscard]] const std::vector<Entry>& entries() const noexcept { return entries_; }
+
+  private:
+    size_t optimal_size_;
+    size_t size_{0};
+    std::vector<Entry> entries_;
+};
+
+}  // namespace zen::etl
@@ -0,0 +1,136 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "collector.hpp"
+
+#include <algorithm>
+
+#include <zen/core/encoding/hex.hpp>
+
+namespace zen::etl {
+
+//! \brief Every this number of loaded entries the load key is updated (for logging purposes)
+static constexpr size_t kLoadKeyUpdateInterval{64 * 1024};
+
+Collector::Collector(NodeSettings* node_settings)
+    : Collector(node_settings->data_directory->etl().path(), node_settings->etl_buffer_size) {}
+
+Collector::Collector(const std::filesystem::path& work_path, size_t optimal_size)
+    : work_path_{work_path}, buffer_{optimal_size} {}
+
+Collector::~Collector() { clear(); }
+
+void Collector::collect(Entry&& entry) {
+    ++size_;
+    bytes_size_ += entry.size();
+    buffer_.put(std::move(entry));
+    if (buffer_.overflows()) {
+        flush_buffer();
+    }
+}
+
+void Collector::flush_buffer() {
+    if (buffer_.empty()) return;
+    if (!work_dir_) {
+        work_dir_ = std::make_unique<TempDirectory>(work_path_);
+    }
+    buffer_.sort();
+    auto provider{std::make_unique<FileProvider>(work_dir_->path(), file_providers_.size())};
+    provider->flush(buffer_);
+    file_providers_.push_back(std::move(provider));
+    buffer_.clear();
+}
+
+void Collector::load(db::Cursor& target, const LoadFunc& load_func, MDBX_put_flags_t flags) {
+    if (empty()) return;
+
+    const auto put_entry{[&target, &load_func, flags](const Entry& entry) {
+        if (load_func) {
+            load_func(entry, target, flags);
+            return;
+        }
+        if (flags & (MDBX_APPEND | MDBX_APPENDDUP)) {
+            (void)db::cursor_append(target, entry.key, entry.value);
+            return;
+        }
+        mdbx::slice value{db::to_slice(entry.value)};
+        mdbx::error::success_or_throw(target.put(db::to_slice(entry.key), &value, flags));
+    }};
+
+    size_t loaded_count{0};
+
+    // Everything fits in memory : no need to go through files
+    if (file_providers_.empty()) {
+        buffer_.sort();
+        for (const auto& entry : buffer_.entries()) {
+            if (loaded_count++ % kLoadKeyUpdateInterval == 0) set_load_key(entry.key);
+            put_entry(entry);
+        }
+        clear();
+        return;
+    }
+
+    flush_buffer();  // Whatever is left
+
+    // K-way merge of sorted runs by means of a min-heap
+    // Ties on same entry are resolved by provider id so older runs are loaded first
+    using QueueItem = std::pair<Entry, size_t>;
+    const auto heap_compare{[](const QueueItem& a, const QueueItem& b) {
+        if (a.first < b.first) return false;
+        if (b.first < a.first) return true;
+        return a.second > b.second;
+    }};
+
+    std::vector<QueueItem> heap;
+    heap.reserve(file_providers_.size());
+    for (auto& provider : file_providers_) {
+        if (auto item{provider->read_entry()}; item.has_value()) {
+            heap.push_back(std::move(*item));
+            std::ranges::push_heap(heap, heap_compare);
+        }
+    }
+
+    while (!heap.empty()) {
+        std::ranges::pop_heap(heap, heap_compare);
+        auto [entry, provider_id]{std::move(heap.back())};
+        heap.pop_back();
+
+        if (loaded_count++ % kLoadKeyUpdateInterval == 0) set_load_key(entry.key);
+        put_entry(entry);
+
+        // Replenish from the same run
+        auto& provider{file_providers_.at(provider_id)};
+        if (auto item{provider->read_entry()}; item.has_value()) {
+            heap.push_back(std::move(*item));
+            std::ranges::push_heap(heap, heap_compare);
+        } else {
+            provider->reset();  // Exhausted : free disk space asap
+        }
+    }
+
+    clear();
+}
+
+void Collector::clear() {
+    buffer_.clear();
+    file_providers_.clear();
+    work_dir_.reset();
+    size_ = 0;
+    bytes_size_ = 0;
+    set_load_key({});
+}
+
+std::string Collector::get_load_key() const {
+    std::scoped_lock lock(load_key_mtx_);
+    return load_key_;
+}
+
+void Collector::set_load_key(ByteView key) {
+    std::scoped_lock lock(load_key_mtx_);
+    load_key_ = key.empty() ? std::string{} : hex::encode(key);
+}
+
+}  // namespace zen::etl
@@ -0,0 +1,99 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <boost/noncopyable.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/common/settings.hpp>
+#include <zen/node/database/mdbx.hpp>
+#include <zen/node/etl/buffer.hpp>
+#include <zen/node/etl/file_provider.hpp>
+
+namespace zen::etl {
+
+//! \brief Default size of the in-memory buffer (see also NodeSettings::etl_buffer_size)
+inline constexpr size_t kOptimalBufferSize{256_MiB};
+
+//! \brief Collects key/value pairs in any order and loads them into a db table in key order
+//! \details Entries are accumulated in memory up to the optimal buffer size. Every time the buffer is full it gets
+//! sorted and flushed into a temporary file (a sorted "run"). On load all runs are k-way merged so the target table
+//! receives its records in ascending key order, which minimizes B-tree page splits and write amplification.
+//! Temporary files live in a unique subdirectory of the provided work path and are removed on clear/destruction.
+class Collector : private boost::noncopyable {
+  public:
+    //! \brief Function invoked on each entry during load in place of the default upsert
+    using LoadFunc = std::function<void(const Entry& entry, db::Cursor& target, MDBX_put_flags_t flags)>;
+
+    //! \brief Creates a collector working in the "etl-tmp" subdir of data directory and sized on etl_buffer_size
+    explicit Collector(NodeSettings* node_settings);
+
+    //! \brief Creates a collector working in the provided path
+    //! \param [in] work_path : the directory where temporary files are stored (must exist)
+    //! \param [in] optimal_size : the size of in-memory buffer after which data is flushed to disk
+    explicit Collector(const std::filesystem::path& work_path, size_t optimal_size = kOptimalBufferSize);
+    ~Collector();
+
+    //! \brief Collects an entry
+    void collect(Entry&& entry);
+
+    //! \brief Collects a key/value pair
+    void collect(Bytes key, Bytes value) { collect(Entry{std::move(key), std::move(value)}); }
+
+    //! \brief Loads all collected entries into the target table in key order
+    //! \param [in] target : a cursor opened on the target table (requires a RW transaction)
+    //! \param [in] load_func : an optional function to transform/write each entry. When empty entries are written
+    //! as they are
+    //! \param [in] flags : the put flags to use on write. With MDBX_APPEND (or MDBX_APPENDDUP) entries are written by
+    //! means of db::cursor_append which falls back to upsert for keys out of order
+    //! \remarks After load the collector is cleared and can be reused
+    void load(db::Cursor& target, const LoadFunc& load_func = {},
+              MDBX_put_flags_t flags = MDBX_put_flags_t::MDBX_UPSERT);
+
+    //! \brief Returns the number of collected entries
+    [[nodiscard]] size_t size() const noexcept { return size_; }
+
+    //! \brief Returns the cumulative size of collected keys and values
+    [[nodiscard]] size_t bytes_size() const noexcept { return bytes_size_; }
+
+    //! \brief Whether no entries have been collected
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    //! \brief Returns the number of sorted runs flushed to disk so far
+    [[nodiscard]] size_t files_count() const noexcept { return file_providers_.size(); }
+
+    //! \brief Returns the (hexed) key being loaded
+    //! \remarks Thread safe as it's meant to be used by logging
+    [[nodiscard]] std::string get_load_key() const;
+
+    //! \brief Discards all collected data and removes temporary files
+    void clear();
+
+  private:
+    //! \brief Sorts the in-memory buffer and flushes it into a new file
+    void flush_buffer();
+
+    //! \brief Records the key being loaded
+    void set_load_key(ByteView key);
+
+    std::filesystem::path work_path_;                            // Where to create the working directory
+    std::unique_ptr<TempDirectory> work_dir_;                    // Working directory for this instance (lazily created)
+    std::vector<std::unique_ptr<FileProvider>> file_providers_;  // One per flushed run
+    Buffer buffer_;                                              // In-memory entries
+    size_t size_{0};                                             // Number of collected entries
+    size_t bytes_size_{0};                                       // Cumulative size of collected entries
+
+    mutable std::mutex load_key_mtx_;  // To synchronize access to load_key_
+    std::string load_key_;             // The hexed key being loaded
+};
+
+}  // namespace zen::etl
@@ -0,0 +1,105 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include <random>
+#include <set>
+
+#include <catch2/catch.hpp>
+
+#include <zen/core/common/cast.hpp>
+#include <zen/core/common/misc.hpp>
+
+#include <zen/node/common/directories.hpp>
+#include <zen/node/etl/collector.hpp>
+
+namespace zen::etl {
+
+static std::vector<Entry> generate_entries(size_t count) {
+    std::vector<Entry> ret;
+    std::set<std::string> keys;
+    while (ret.size() < count) {
+        auto key{get_random_alpha_string(8)};
+        if (!keys.insert(key).second) continue;  // Avoid duplicates
+        ret.push_back({Bytes(string_view_to_byte_view(key)), Bytes(string_view_to_byte_view(key + "_value"))});
+    }
+    return ret;
+}
+
+static void run_collector_test(size_t entries_count, size_t buffer_size, bool expect_files) {
+    TempDirectory data_dir{};
+    db::EnvConfig db_config{data_dir.path().string(), /*create=*/true};
+    db_config.inmemory = true;
+    auto env{db::open_env(db_config)};
+    db::RWTxn txn(env);
+    const db::MapConfig target_map{"Target"};
+
+    auto entries{generate_entries(entries_count)};
+    Collector collector(data_dir.path(), buffer_size);
+    for (auto entry : entries) {
+        collector.collect(std::move(entry));
+    }
+    CHECK(collector.size() == entries_count);
+    CHECK((collector.files_count() != 0) == expect_files);
+
+    db::Cursor target(txn, target_map);
+    collector.load(target);
+    CHECK(collector.empty());
+    CHECK(collector.files_count() == 0);
+    CHECK(target.size() == entries_count);
+
+    // Data must be there in key order
+    std::sort(entries.begin(), entries.end());
+    size_t i{0};
+    target.to_first(/*throw_notfound=*/false);
+    db::cursor_for_each(target, [&entries, &i](ByteView key, ByteView value) {
+        REQUIRE(i < entries.size());
+        CHECK(key == entries[i].key);
+        CHECK(value == entries[i].value);
+        ++i;
+    });
+    CHECK(i == entries_count);
+
+    // Working directory has been removed
+    CHECK(data_dir.is_pristine());
+}
+
+TEST_CASE("ETL Collector", "[etl]") {
+    SECTION("Empty") {
+        TempDirectory data_dir{};
+        Collector collector(data_dir.path());
+        CHECK(collector.empty());
+        CHECK(collector.get_load_key().empty());
+    }
+
+    SECTION("In memory only") { run_collector_test(1'000, 1_MiB, /*expect_files=*/false); }
+
+    SECTION("With flushed files") { run_collector_test(10'000, 4_KiB, /*expect_files=*/true); }
+
+    SECTION("Load function") {
+        TempDirectory data_dir{};
+        db::EnvConfig db_config{data_dir.path().string(), /*create=*/true};
+        db_config.inmemory = true;
+        auto env{db::open_env(db_config)};
+        db::RWTxn txn(env);
+
+        Collector collector(data_dir.path(), 1_KiB);
+        for (auto& entry : generate_entries(500)) {
+            collector.collect(std::move(entry));
+        }
+
+        // Only keep keys starting with 'a' and drop values
+        db::Cursor target(txn, {"Target"});
+        size_t expected_count{0};
+        collector.load(target, [&expected_count](const Entry& entry, db::Cursor& cursor, MDBX_put_flags_t) {
+            if (entry.key[0] != 'a') return;
+            ++expected_count;
+            cursor.upsert(db::to_slice(entry.key), mdbx::slice{});
+        });
+        CHECK(target.size() == expected_count);
+    }
+}
+
+}  // namespace zen::etl
@@ -0,0 +1,80 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#include "file_provider.hpp"
+
+#include <array>
+#include <limits>
+
+#include <zen/core/common/cast.hpp>
+#include <zen/core/common/endian.hpp>
+
+namespace zen::etl {
+
+FileProvider::FileProvider(const std::filesystem::path& working_path, size_t id)
+    : id_{id}, file_path_{working_path / ("tmp-" + std::to_string(id) + ".etl")} {}
+
+FileProvider::~FileProvider() { reset(); }
+
+void FileProvider::flush(const Buffer& buffer) {
+    file_.open(file_path_, std::ios::out | std::ios::in | std::ios::binary | std::ios::trunc);
+    if (!file_.is_open()) {
+        throw EtlError("Unable to create file " + file_path_.string());
+    }
+
+    std::array<uint8_t, kRecordHeaderSize> header{};
+    for (const auto& entry : buffer.entries()) {
+        if (entry.key.size() > std::numeric_limits<uint32_t>::max() ||
+            entry.value.size() > std::numeric_limits<uint32_t>::max()) [[unlikely]] {
+            throw EtlError("Entry too large for ETL file " + file_path_.string());
+        }
+        endian::store_little_u32(&header[0], static_cast<uint32_t>(entry.key.size()));
+        endian::store_little_u32(&header[sizeof(uint32_t)], static_cast<uint32_t>(entry.value.size()));
+        file_.write(byte_ptr_cast(header.data()), header.size());
+        file_.write(byte_ptr_cast(entry.key.data()), static_cast<std::streamsize>(entry.key.size()));
+        file_.write(byte_ptr_cast(entry.value.data()), static_cast<std::streamsize>(entry.value.size()));
+        if (file_.fail()) [[unlikely]] {
+            throw EtlError("Unable to write into file " + file_path_.string());
+        }
+        file_size_ += header.size() + entry.size();
+    }
+
+    file_.flush();
+    file_.seekg(0);
+}
+
+std::optional<std::pair<Entry, size_t>> FileProvider::read_entry() {
+    if (!file_.is_open() || file_.peek() == std::char_traits<char>::eof()) {
+        return std::nullopt;
+    }
+
+    std::array<uint8_t, kRecordHeaderSize> header{};
+    file_.read(byte_ptr_cast(header.data()), header.size());
+    if (file_.fail()) [[unlikely]] {
+        throw EtlError("Unable to read record header from file " + file_path_.string());
+    }
+
+    Entry entry;
+    entry.key.resize(endian::load_little_u32(&header[0]));
+    entry.value.resize(endian::load_little_u32(&header[sizeof(uint32_t)]));
+    file_.read(byte_ptr_cast(entry.key.data()), static_cast<std::streamsize>(entry.key.size()));
+    file_.read(byte_ptr_cast(entry.value.data()), static_cast<std::streamsize>(entry.value.size()));
+    if (file_.fail()) [[unlikely]] {
+        throw EtlError("Unable to read record data from file " + file_path_.string());
+    }
+    return std::make_pair(std::move(entry), id_);
+}
+
+void FileProvider::reset() {
+    if (file_.is_open()) {
+        file_.close();
+    }
+    std::error_code ec;
+    std::ignore = std::filesystem::remove(file_path_, ec);
+    file_size_ = 0;
+}
+
+}  // namespace zen::etl
@@ -0,0 +1,57 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <utility>
+
+#include <boost/noncopyable.hpp>
+
+#include <zen/node/etl/buffer.hpp>
+
+namespace zen::etl {
+
+//! \brief Handles the lifecycle of a temporary file holding a sorted run of entries
+//! \details Each record is laid out as
+//! \verbatim
+//!   key_length   : u32 (LE)
+//!   value_length : u32 (LE)
+//!   key          : key_length bytes
+//!   value        : value_length bytes
+//! \endverbatim
+class FileProvider : private boost::noncopyable {
+  public:
+    //! \param [in] working_path : the directory where the file is created (must exist)
+    //! \param [in] id : unique identifier of this provider (also names the file)
+    FileProvider(const std::filesystem::path& working_path, size_t id);
+    ~FileProvider();
+
+    //! \brief Writes the contents of a sorted buffer into the file and rewinds it for reading
+    void flush(const Buffer& buffer);
+
+    //! \brief Reads the next entry from the file
+    //! \return The entry paired with the id of this provider or std::nullopt when the file is exhausted
+    std::optional<std::pair<Entry, size_t>> read_entry();
+
+    //! \brief Closes and removes the underlying file
+    void reset();
+
+    [[nodiscard]] size_t id() const noexcept { return id_; }
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return file_path_; }
+    [[nodiscard]] size_t size() const noexcept { return file_size_; }
+
+  private:
+    static constexpr size_t kRecordHeaderSize{2 * sizeof(uint32_t)};
+
+    size_t id_;
+    std::filesystem::path file_path_;
+    std::fstream file_;
+    size_t file_size_{0};
+};
+
+}  // namespace zen::etl
@@ -0,0 +1,40 @@
+/*
+   Copyright 2023 Horizen Labs
+   Distributed under the MIT software license, see the accompanying
+   file COPYING or http://www.opensource.org/licenses/mit-license.php.
+*/
+
+#pragma once
+#include <stdexcept>
+
+#include <zen/core/common/base.hpp>
+
+namespace zen::etl {
+
+//! \brief Specific exception for ETL operations
+class EtlError : public std::runtime_error {
+  public:
+    explicit EtlError(const char* message) : std::runtime_error(message){};
+    explicit EtlError(const std::string& message) : std::runtime_error(message){};
+};
+
+//! \brief The unit of data handled by ETL : a key/value pair
+struct Entry {
+    Bytes key;
+    Bytes value;
+
+    //! \brief Returns the cumulative size of key and value
+    [[nodiscard]] size_t size() const noexcept { return key.size() + value.size(); }
+};
+
+//! \brief Entries are ordered by key first and then by value (same collation MDBX applies to usual keys and
+//! multi-values)
+inline bool operator<(const Entry& a, const Entry& b) {
+    const auto diff{a.key.compare(b.key)};
+    if (diff == 0) {
+        return a.value < b.value;
+    }
+    return diff < 0;
+}
+
+}  // namespace zen::etl
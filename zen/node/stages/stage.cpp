@@ -22,6 +22,11 @@ void Stage::update_progress(db::RWTxn& txn, BlockNum progress) {
     db::stages::write_stage_progress(*txn, stage_name_, progress);
 }
 
+bool Stage::safe_point(db::RWTxn& txn) {
+    txn.set_dirty_budget(node_settings_->batch_size);
+    return txn.safe_point();
+}
+
 void Stage::check_block_sequence(BlockNum actual, BlockNum expected) {
     if (actual != expected) {
         const std::string what{"bad block sequence : expected " + std::to_string(expected) + " got " +
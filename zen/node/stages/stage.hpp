@@ -92,6 +92,11 @@ class Stage : public Stoppable {
     //! \brief Updates current stage progress
     void update_progress(db::RWTxn& txn, BlockNum progress);
 
+    //! \brief Declares a safe point in stage's work : should the transaction's dirty data exceed the configured
+    //! batch_size (or the room for dirty pages run low) the transaction is committed and renewed
+    //! \return Whether the transaction has been committed (cursors need to be rebound)
+    bool safe_point(db::RWTxn& txn);
+
     //! \brief Sets the prefix for logging lines produced by stage itself
     void set_log_prefix(const std::string_view prefix) { log_prefix_ = prefix; };
 